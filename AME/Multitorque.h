@@ -528,33 +528,30 @@ class SetCalibrationMatrixRow
   public:
     SetCalibrationMatrixRow() : header(MESSAGE_ID__SET_CALIBRATION_MATRIX_ROW) ,
       row(),
-      c0(),
-      c1(),
-      c2(),
-      c3(),
-      c4(),
-      c5()
+      c()
     { }
 
     // Get methods.
     LIBHeader getHeader() const     { return header;  }
     uint32_t getRow() const     { return row;  }
-    float getC0() const     { return c0;  }
-    float getC1() const     { return c1;  }
-    float getC2() const     { return c2;  }
-    float getC3() const     { return c3;  }
-    float getC4() const     { return c4;  }
-    float getC5() const     { return c5;  }
+    float getC0() const     { return c[0];  }
+    float getC1() const     { return c[1];  }
+    float getC2() const     { return c[2];  }
+    float getC3() const     { return c[3];  }
+    float getC4() const     { return c[4];  }
+    float getC5() const     { return c[5];  }
+    const float* getCoefficients() const     { return c;  }
 
     // Set methods.
     void setHeader(const LIBHeader& _h)    { header = _h;  }
     void setRow(const uint32_t& _r)    { row = _r;  }
-    void setC0(const float& _c)    { c0 = _c;  }
-    void setC1(const float& _c)    { c1 = _c;  }
-    void setC2(const float& _c)    { c2 = _c;  }
-    void setC3(const float& _c)    { c3 = _c;  }
-    void setC4(const float& _c)    { c4 = _c;  }
-    void setC5(const float& _c)    { c5 = _c;  }
+    void setC0(const float& _c)    { c[0] = _c;  }
+    void setC1(const float& _c)    { c[1] = _c;  }
+    void setC2(const float& _c)    { c[2] = _c;  }
+    void setC3(const float& _c)    { c[3] = _c;  }
+    void setC4(const float& _c)    { c[4] = _c;  }
+    void setC5(const float& _c)    { c[5] = _c;  }
+    void setCoefficients(const float* _c)    { memcpy(c, _c, sizeof(c));  }
 
     // Header direct access methods
     uint16_t getHeaderId() const     { return header.getId();  }
@@ -564,12 +561,8 @@ class SetCalibrationMatrixRow
   private:
     LIBHeader header;
     uint32_t row;
-    float c0;
-    float c1;
-    float c2;
-    float c3;
-    float c4;
-    float c5;
+    // c0 to c5, contiguous to be encoded as an array
+    float c[6];
 };
 
 /**************************************************/
@@ -630,33 +623,30 @@ class ReplyGetCalibrationMatrixRow
   public:
     ReplyGetCalibrationMatrixRow() : header(MESSAGE_ID__REPLY_GET_CALIBRATION_MATRIX_ROW) ,
       row(),
-      c0(),
-      c1(),
-      c2(),
-      c3(),
-      c4(),
-      c5()
+      c()
     { }
 
     // Get methods.
     LIBHeader getHeader() const     { return header;  }
     uint32_t getRow() const     { return row;  }
-    float getC0() const     { return c0;  }
-    float getC1() const     { return c1;  }
-    float getC2() const     { return c2;  }
-    float getC3() const     { return c3;  }
-    float getC4() const     { return c4;  }
-    float getC5() const     { return c5;  }
+    float getC0() const     { return c[0];  }
+    float getC1() const     { return c[1];  }
+    float getC2() const     { return c[2];  }
+    float getC3() const     { return c[3];  }
+    float getC4() const     { return c[4];  }
+    float getC5() const     { return c[5];  }
+    const float* getCoefficients() const     { return c;  }
 
     // Set methods.
     void setHeader(const LIBHeader& _h)    { header = _h;  }
     void setRow(const uint32_t& _r)    { row = _r;  }
-    void setC0(const float& _c)    { c0 = _c;  }
-    void setC1(const float& _c)    { c1 = _c;  }
-    void setC2(const float& _c)    { c2 = _c;  }
-    void setC3(const float& _c)    { c3 = _c;  }
-    void setC4(const float& _c)    { c4 = _c;  }
-    void setC5(const float& _c)    { c5 = _c;  }
+    void setC0(const float& _c)    { c[0] = _c;  }
+    void setC1(const float& _c)    { c[1] = _c;  }
+    void setC2(const float& _c)    { c[2] = _c;  }
+    void setC3(const float& _c)    { c[3] = _c;  }
+    void setC4(const float& _c)    { c[4] = _c;  }
+    void setC5(const float& _c)    { c[5] = _c;  }
+    void setCoefficients(const float* _c)    { memcpy(c, _c, sizeof(c));  }
 
     // Header direct access methods
     uint16_t getHeaderId() const     { return header.getId();  }
@@ -666,12 +656,8 @@ class ReplyGetCalibrationMatrixRow
   private:
     LIBHeader header;
     uint32_t row;
-    float c0;
-    float c1;
-    float c2;
-    float c3;
-    float c4;
-    float c5;
+    // c0 to c5, contiguous to be encoded as an array
+    float c[6];
 };
 
 /**************************************************/
@@ -747,49 +733,40 @@ class BCastSensorData
 {
   public:
     BCastSensorData() : header(MESSAGE_ID__B_CAST_SENSOR_DATA) ,
-      Fx(),
-      Fy(),
-      Fz(),
-      Tx(),
-      Ty(),
-      Tz(),
-      raw0(),
-      raw1(),
-      raw2(),
-      raw3(),
-      raw4(),
-      raw5()
+      values()
     { }
 
     // Get methods.
     LIBHeader getHeader() const     { return header;  }
-    float getFx() const     { return Fx;  }
-    float getFy() const     { return Fy;  }
-    float getFz() const     { return Fz;  }
-    float getTx() const     { return Tx;  }
-    float getTy() const     { return Ty;  }
-    float getTz() const     { return Tz;  }
-    float getRaw0() const     { return raw0;  }
-    float getRaw1() const     { return raw1;  }
-    float getRaw2() const     { return raw2;  }
-    float getRaw3() const     { return raw3;  }
-    float getRaw4() const     { return raw4;  }
-    float getRaw5() const     { return raw5;  }
+    float getFx() const     { return values[0];  }
+    float getFy() const     { return values[1];  }
+    float getFz() const     { return values[2];  }
+    float getTx() const     { return values[3];  }
+    float getTy() const     { return values[4];  }
+    float getTz() const     { return values[5];  }
+    float getRaw0() const     { return values[6];  }
+    float getRaw1() const     { return values[7];  }
+    float getRaw2() const     { return values[8];  }
+    float getRaw3() const     { return values[9];  }
+    float getRaw4() const     { return values[10];  }
+    float getRaw5() const     { return values[11];  }
+    const float* getValues() const     { return values;  }
 
     // Set methods.
     void setHeader(const LIBHeader& _h)    { header = _h;  }
-    void setFx(const float& _F)    { Fx = _F;  }
-    void setFy(const float& _F)    { Fy = _F;  }
-    void setFz(const float& _F)    { Fz = _F;  }
-    void setTx(const float& _T)    { Tx = _T;  }
-    void setTy(const float& _T)    { Ty = _T;  }
-    void setTz(const float& _T)    { Tz = _T;  }
-    void setRaw0(const float& _r)    { raw0 = _r;  }
-    void setRaw1(const float& _r)    { raw1 = _r;  }
-    void setRaw2(const float& _r)    { raw2 = _r;  }
-    void setRaw3(const float& _r)    { raw3 = _r;  }
-    void setRaw4(const float& _r)    { raw4 = _r;  }
-    void setRaw5(const float& _r)    { raw5 = _r;  }
+    void setFx(const float& _F)    { values[0] = _F;  }
+    void setFy(const float& _F)    { values[1] = _F;  }
+    void setFz(const float& _F)    { values[2] = _F;  }
+    void setTx(const float& _T)    { values[3] = _T;  }
+    void setTy(const float& _T)    { values[4] = _T;  }
+    void setTz(const float& _T)    { values[5] = _T;  }
+    void setRaw0(const float& _r)    { values[6] = _r;  }
+    void setRaw1(const float& _r)    { values[7] = _r;  }
+    void setRaw2(const float& _r)    { values[8] = _r;  }
+    void setRaw3(const float& _r)    { values[9] = _r;  }
+    void setRaw4(const float& _r)    { values[10] = _r;  }
+    void setRaw5(const float& _r)    { values[11] = _r;  }
+    void setValues(const float* _v)    { memcpy(values, _v, sizeof(values));  }
 
     // Header direct access methods
     uint16_t getHeaderId() const     { return header.getId();  }
@@ -798,18 +775,8 @@ class BCastSensorData
 
   private:
     LIBHeader header;
-    float Fx;
-    float Fy;
-    float Fz;
-    float Tx;
-    float Ty;
-    float Tz;
-    float raw0;
-    float raw1;
-    float raw2;
-    float raw3;
-    float raw4;
-    float raw5;
+    // Fx, Fy, Fz, Tx, Ty, Tz then raw0 to raw5, contiguous to be encoded as an array
+    float values[12];
 };
 
 /**************************************************/
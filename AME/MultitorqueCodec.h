@@ -0,0 +1,433 @@
+#ifndef _MULTITORQUECODEC_H_
+#define _MULTITORQUECODEC_H_
+
+#include "Multitorque.h"
+#include "baseTypeEncoding.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// Generic encoder and decoder of the Multitorque messages.
+//
+// On the wire a message is a header word (id, size and encoding) followed by one
+// 32 bit little endian word per field, whatever the type of the field.
+// Every message is then described once by the list of its fields (MessageLayout below):
+// it is encoded and decoded with a single size check and a single memcpy of the whole
+// message, the fields being converted from/to the words by inlined accessors.
+// The fields kept as arrays (e.g. the values of BCastSensorData) are converted at once
+// by the array codec of baseTypeEncoding.h.
+
+namespace Multitorque
+{
+namespace Codec
+{
+
+// Conversion of the field values from/to the wire words
+inline uint32_t toWord(const uint32_t value)  { return value; }
+inline uint32_t toWord(const int32_t value)   { return (uint32_t)value; }
+inline uint32_t toWord(const uint8_t value)   { return value; }
+inline uint32_t toWord(const float value)     { uint32_t word; memcpy(&word, &value, 4); return word; }
+template <typename Enum>
+inline uint32_t toWord(const Enum value)      { return (uint32_t)(int32_t)value; }
+
+inline void fromWord(const uint32_t word, uint32_t& value)  { value = word; }
+inline void fromWord(const uint32_t word, int32_t& value)   { value = (int32_t)word; }
+inline void fromWord(const uint32_t word, uint8_t& value)   { value = (uint8_t)(word & 0xff); }
+inline void fromWord(const uint32_t word, float& value)     { memcpy(&value, &word, 4); }
+template <typename Enum>
+inline void fromWord(const uint32_t word, Enum& value)      { value = (Enum)(int32_t)word; }
+
+inline uint32_t packHeader(const uint16_t id, const uint16_t size, const uint8_t encoding)
+{
+  return ((uint32_t)(id & 0x0fff) << 20) | ((uint32_t)(encoding & 0x0f) << 16) | size;
+}
+
+inline LIBHeader unpackHeader(const uint32_t word)
+{
+  LIBHeader header;
+  header.setId((uint16_t)((word & 0xfff00000) >> 20));
+  header.setSize((uint16_t)(word & 0x0000ffff));
+  header.setEncoding((uint8_t)((word & 0x000f0000) >> 16));
+  return header;
+}
+
+// Conversion of the words from/to little endian, in place
+inline void wordsToLittleEndian(uint32_t* words, const size_t count)
+{
+#ifdef LIB_HOST_BIG_ENDIAN
+  for(size_t i = 0; i < count; ++i)
+    words[i] = bswap_32(words[i]);
+#else
+  (void)words; (void)count;
+#endif
+}
+
+// One field of a message, accessed through its get and set methods
+template <typename Message, typename T, T (Message::*Get)() const, void (Message::*Set)(const T&)>
+struct Field
+{
+  enum { words = 1 };
+  static void store(const Message& message, uint32_t* word)
+  {
+    *word = toWord((message.*Get)());
+    wordsToLittleEndian(word, 1);
+  }
+  static void load(Message& message, const uint32_t* word)
+  {
+    uint32_t host = *word;
+    wordsToLittleEndian(&host, 1);
+    T value;
+    fromWord(host, value);
+    (message.*Set)(value);
+  }
+};
+
+// Count consecutive fields of the same 32 bit type, accessed as an array
+template <typename Message, typename T, size_t Count, const T* (Message::*Get)() const, void (Message::*Set)(const T*)>
+struct ArrayField
+{
+  enum { words = Count };
+  static void store(const Message& message, uint32_t* words)
+  {
+    LIB::encodeArray((message.*Get)(), Count, (uint8_t*)words, 4 * Count);
+  }
+  static void load(Message& message, const uint32_t* words)
+  {
+    T values[Count];
+    LIB::decodeArray(values, Count, (const uint8_t*)words, 4 * Count);
+    (message.*Set)(values);
+  }
+};
+
+// Ordered list of the fields of a message (the header excluded), with their number of words
+template <typename... Fields>
+struct FieldList;
+
+template <>
+struct FieldList<>
+{
+  enum { count = 0 };
+  template <typename Message> static void store(const Message&, uint32_t*) {}
+  template <typename Message> static void load(Message&, const uint32_t*) {}
+};
+
+template <typename First, typename... Rest>
+struct FieldList<First, Rest...>
+{
+  enum { count = First::words + FieldList<Rest...>::count };
+  template <typename Message> static void store(const Message& message, uint32_t* words)
+  {
+    First::store(message, words);
+    FieldList<Rest...>::store(message, words + First::words);
+  }
+  template <typename Message> static void load(Message& message, const uint32_t* words)
+  {
+    First::load(message, words);
+    FieldList<Rest...>::load(message, words + First::words);
+  }
+};
+
+// Layout of each message: its id and the list of its fields.
+template <typename Message>
+struct MessageLayout;
+
+template <typename Message>
+struct MessageSize
+{
+  enum { words = 1 + MessageLayout<Message>::Fields::count, bytes = 4 * words };
+};
+
+template <typename Message>
+int32_t encodeMessage(const Message& message, uint8_t* binary, const size_t maxSize)
+{
+  typedef MessageLayout<Message> Layout;
+  CHECK_BUFFER_SIZE(maxSize, (size_t)MessageSize<Message>::bytes)
+
+  uint32_t words[MessageSize<Message>::words];
+  words[0] = packHeader(Layout::id, MessageSize<Message>::bytes, ENCODING_TYPE);
+  wordsToLittleEndian(words, 1);
+  Layout::Fields::store(message, words + 1);
+  memcpy(binary, words, MessageSize<Message>::bytes);
+
+  return MessageSize<Message>::bytes;
+}
+
+template <typename Message>
+int32_t decodeMessage(Message& message, const uint8_t* binary, const size_t maxSize)
+{
+  typedef MessageLayout<Message> Layout;
+  CHECK_BUFFER_SIZE(maxSize, (size_t)MessageSize<Message>::bytes)
+
+  uint32_t words[MessageSize<Message>::words];
+  memcpy(words, binary, MessageSize<Message>::bytes);
+  uint32_t header = words[0];
+  wordsToLittleEndian(&header, 1);
+  message.setHeader(unpackHeader(header));
+  Layout::Fields::load(message, words + 1);
+
+  return MessageSize<Message>::bytes;
+}
+
+} // namespace Codec
+
+#define MULTITORQUE_FIELD(Message, Type, Name) \
+  Codec::Field<Message, Type, &Message::get##Name, &Message::set##Name>
+
+#define MULTITORQUE_ARRAY_FIELD(Message, Type, Count, Name) \
+  Codec::ArrayField<Message, Type, Count, &Message::get##Name, &Message::set##Name>
+
+#define MULTITORQUE_LAYOUT(Message, Id) \
+  namespace Codec { \
+  template <> struct MessageLayout<Message> \
+  { \
+    enum { id = Id }; \
+    typedef FieldList<
+
+#define MULTITORQUE_LAYOUT_END \
+    > Fields; \
+  }; \
+  }
+
+// Message layouts
+MULTITORQUE_LAYOUT(GetBoardInfo, MESSAGE_ID__GET_BOARD_INFO)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyBoardInfo, MESSAGE_ID__REPLY_BOARD_INFO)
+  MULTITORQUE_FIELD(ReplyBoardInfo, uint32_t, Release)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(CalibrateOffsets, MESSAGE_ID__CALIBRATE_OFFSETS)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyCalibrateOffsets, MESSAGE_ID__REPLY_CALIBRATE_OFFSETS)
+  MULTITORQUE_FIELD(ReplyCalibrateOffsets, BoardReturnCode, Brc)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetFault, MESSAGE_ID__GET_FAULT)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyFault, MESSAGE_ID__REPLY_FAULT)
+  MULTITORQUE_FIELD(ReplyFault, uint32_t, Fault)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ClearFault, MESSAGE_ID__CLEAR_FAULT)
+  MULTITORQUE_FIELD(ClearFault, BoardReturnCode, Brc)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyClearFault, MESSAGE_ID__REPLY_CLEAR_FAULT)
+  MULTITORQUE_FIELD(ReplyClearFault, uint32_t, Fault)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetSampleStreamPolicy, MESSAGE_ID__SET_SAMPLE_STREAM_POLICY)
+  MULTITORQUE_FIELD(SetSampleStreamPolicy, SampleStreamPolicy, Policy),
+  MULTITORQUE_FIELD(SetSampleStreamPolicy, uint32_t, Rate)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplySetSampleStreamPolicy, MESSAGE_ID__REPLY_SET_SAMPLE_STREAM_POLICY)
+  MULTITORQUE_FIELD(ReplySetSampleStreamPolicy, BoardReturnCode, Brc)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetSampleStreamPolicy, MESSAGE_ID__GET_SAMPLE_STREAM_POLICY)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetSampleStreamPolicy, MESSAGE_ID__REPLY_GET_SAMPLE_STREAM_POLICY)
+  MULTITORQUE_FIELD(ReplyGetSampleStreamPolicy, SampleStreamPolicy, Policy)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetTempFactors, MESSAGE_ID__SET_TEMP_FACTORS)
+  MULTITORQUE_FIELD(SetTempFactors, uint32_t, T0),
+  MULTITORQUE_FIELD(SetTempFactors, uint32_t, T1),
+  MULTITORQUE_FIELD(SetTempFactors, uint32_t, T2),
+  MULTITORQUE_FIELD(SetTempFactors, uint32_t, T3),
+  MULTITORQUE_FIELD(SetTempFactors, uint32_t, T4),
+  MULTITORQUE_FIELD(SetTempFactors, uint32_t, T5)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplySetTempFactors, MESSAGE_ID__REPLY_SET_TEMP_FACTORS)
+  MULTITORQUE_FIELD(ReplySetTempFactors, SampleStreamPolicy, Policy)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetCalibrationTemp, MESSAGE_ID__GET_CALIBRATION_TEMP)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetCalibrationTemp, MESSAGE_ID__REPLY_GET_CALIBRATION_TEMP)
+  MULTITORQUE_FIELD(ReplyGetCalibrationTemp, int32_t, CalibrationTemp)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetCalibrationMatrixRow, MESSAGE_ID__SET_CALIBRATION_MATRIX_ROW)
+  MULTITORQUE_FIELD(SetCalibrationMatrixRow, uint32_t, Row),
+  MULTITORQUE_ARRAY_FIELD(SetCalibrationMatrixRow, float, 6, Coefficients)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplySetCalibrationMatrixRow, MESSAGE_ID__REPLY_SET_CALIBRATION_MATRIX_ROW)
+  MULTITORQUE_FIELD(ReplySetCalibrationMatrixRow, BoardReturnCode, Brc)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetCalibrationMatrixRow, MESSAGE_ID__GET_CALIBRATION_MATRIX_ROW)
+  MULTITORQUE_FIELD(GetCalibrationMatrixRow, uint32_t, Row)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetCalibrationMatrixRow, MESSAGE_ID__REPLY_GET_CALIBRATION_MATRIX_ROW)
+  MULTITORQUE_FIELD(ReplyGetCalibrationMatrixRow, uint32_t, Row),
+  MULTITORQUE_ARRAY_FIELD(ReplyGetCalibrationMatrixRow, float, 6, Coefficients)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetCalibrationOffsets, MESSAGE_ID__GET_CALIBRATION_OFFSETS)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetCalibrationOffsets, MESSAGE_ID__REPLY_GET_CALIBRATION_OFFSETS)
+  MULTITORQUE_FIELD(ReplyGetCalibrationOffsets, uint32_t, C0),
+  MULTITORQUE_FIELD(ReplyGetCalibrationOffsets, uint32_t, C1),
+  MULTITORQUE_FIELD(ReplyGetCalibrationOffsets, uint32_t, C2),
+  MULTITORQUE_FIELD(ReplyGetCalibrationOffsets, uint32_t, C3),
+  MULTITORQUE_FIELD(ReplyGetCalibrationOffsets, uint32_t, C4),
+  MULTITORQUE_FIELD(ReplyGetCalibrationOffsets, uint32_t, C5)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(BCastSensorData, MESSAGE_ID__B_CAST_SENSOR_DATA)
+  MULTITORQUE_ARRAY_FIELD(BCastSensorData, float, 12, Values)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SaveParamsOnFlash, MESSAGE_ID__SAVE_PARAMS_ON_FLASH)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetIpAddress, MESSAGE_ID__SET_IP_ADDRESS)
+  MULTITORQUE_FIELD(SetIpAddress, uint32_t, IpAddress)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetIpAddress, MESSAGE_ID__GET_IP_ADDRESS)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetIpAddress, MESSAGE_ID__REPLY_GET_IP_ADDRESS)
+  MULTITORQUE_FIELD(ReplyGetIpAddress, uint32_t, IpAddress)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetMacAddress, MESSAGE_ID__SET_MAC_ADDRESS)
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M0),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M1),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M2),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M3),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M4),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M5),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M6),
+  MULTITORQUE_FIELD(SetMacAddress, uint8_t, M7)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplySetMacAddress, MESSAGE_ID__REPLY_SET_MAC_ADDRESS)
+  MULTITORQUE_FIELD(ReplySetMacAddress, MacAddressReturnCode, Macrc)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetMacAddress, MESSAGE_ID__GET_MAC_ADDRESS)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetMacAddress, MESSAGE_ID__REPLY_GET_MAC_ADDRESS)
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M0),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M1),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M2),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M3),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M4),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M5),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M6),
+  MULTITORQUE_FIELD(ReplyGetMacAddress, uint8_t, M7)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetNetmask, MESSAGE_ID__SET_NETMASK)
+  MULTITORQUE_FIELD(SetNetmask, uint32_t, Netmask)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetNetmask, MESSAGE_ID__GET_NETMASK)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetNetmask, MESSAGE_ID__REPLY_GET_NETMASK)
+  MULTITORQUE_FIELD(ReplyGetNetmask, uint32_t, Netmask)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SetGateway, MESSAGE_ID__SET_GATEWAY)
+  MULTITORQUE_FIELD(SetGateway, uint32_t, Gateway)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(GetGateway, MESSAGE_ID__GET_GATEWAY)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyGetGateway, MESSAGE_ID__REPLY_GET_GATEWAY)
+  MULTITORQUE_FIELD(ReplyGetGateway, uint32_t, Gateway)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(SaveInventoryDataOnFlash, MESSAGE_ID__SAVE_INVENTORY_DATA_ON_FLASH)
+  MULTITORQUE_FIELD(SaveInventoryDataOnFlash, uint32_t, DesignCode),
+  MULTITORQUE_FIELD(SaveInventoryDataOnFlash, uint32_t, BoardVer),
+  MULTITORQUE_FIELD(SaveInventoryDataOnFlash, uint32_t, BoardRev),
+  MULTITORQUE_FIELD(SaveInventoryDataOnFlash, uint32_t, SerialNumber),
+  MULTITORQUE_FIELD(SaveInventoryDataOnFlash, uint32_t, DateTime)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(LoadInventoryDataFromFlash, MESSAGE_ID__LOAD_INVENTORY_DATA_FROM_FLASH)
+MULTITORQUE_LAYOUT_END
+
+MULTITORQUE_LAYOUT(ReplyLoadInventoryDataFromFlash, MESSAGE_ID__REPLY_LOAD_INVENTORY_DATA_FROM_FLASH)
+  MULTITORQUE_FIELD(ReplyLoadInventoryDataFromFlash, uint32_t, DesignCode),
+  MULTITORQUE_FIELD(ReplyLoadInventoryDataFromFlash, uint32_t, BoardVer),
+  MULTITORQUE_FIELD(ReplyLoadInventoryDataFromFlash, uint32_t, BoardRev),
+  MULTITORQUE_FIELD(ReplyLoadInventoryDataFromFlash, uint32_t, SerialNumber),
+  MULTITORQUE_FIELD(ReplyLoadInventoryDataFromFlash, uint32_t, DateTime)
+MULTITORQUE_LAYOUT_END
+
+namespace Codec
+{
+
+// Outcome of the validation of a received message
+enum ViewStatus
+{
+  VIEW_VALID = 0,
+  VIEW_TOO_SHORT,   // the datagram is shorter than the message
+  VIEW_WRONG_ID,    // the datagram carries another message
+  VIEW_MALFORMED    // the header size or encoding do not match the message
+};
+
+// Read only view of a message in a received buffer.
+// The header is checked once at construction, then the fields are copied straight
+// from the buffer, without building the message object. The buffer must outlive the view.
+template <typename Message>
+class MessageView
+{
+public:
+  MessageView(const uint8_t* binary, const size_t size) : binary(binary), status(check(binary, size)) {}
+
+  ViewStatus getStatus() const { return status; }
+  bool isValid() const { return status == VIEW_VALID; }
+
+  // Copy count consecutive 32 bit fields, starting from the field with index first
+  template <typename T>
+  void copyFields(const size_t first, const size_t count, T* values) const
+  {
+    // the view has been checked against the size of the whole message
+    LIB::decodeArray(values, count, binary + 4 * (1 + first), 4 * count);
+  }
+
+private:
+  static ViewStatus check(const uint8_t* binary, const size_t size)
+  {
+    if(size < 4)
+      return VIEW_TOO_SHORT;
+    uint32_t word;
+    memcpy(&word, binary, 4);
+    wordsToLittleEndian(&word, 1);
+    LIBHeader header = unpackHeader(word);
+    if(header.getId() != MessageLayout<Message>::id)
+      return VIEW_WRONG_ID;
+    if(size < (size_t)MessageSize<Message>::bytes)
+      return VIEW_TOO_SHORT;
+    if(header.getSize() != MessageSize<Message>::bytes || header.getEncoding() != ENCODING_TYPE)
+      return VIEW_MALFORMED;
+    return VIEW_VALID;
+  }
+
+  const uint8_t* binary;
+  const ViewStatus status;
+};
+
+} // namespace Codec
+
+} // namespace Multitorque
+
+#endif  // _MULTITORQUECODEC_H_
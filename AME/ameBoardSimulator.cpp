@@ -0,0 +1,526 @@
+/**
+ * @file
+ * @version 1.0
+ *
+ * @copyright (c) IIT Fondazione Istituto Italiano
+ *            di Tecnologia. All rights reserved
+ *
+ * @brief Simulator of AME boards: it answers the Multitorque commands over TCP
+ *        and broadcasts BCastSensorData over UDP, to run the AME stack without hardware.
+ *
+ *        Board i listens on <first address> + i (e.g. 127.0.0.2, 127.0.0.3, ... on the loopback),
+ *        so that several boards can be simulated by a single process on one machine.
+ */
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Multitorque.h"
+#include "MultitorqueEncoder.h"
+#include "MultitorqueCodec.h"
+#include "ethService.h"
+
+using namespace Multitorque;
+
+namespace
+{
+
+std::atomic<bool> running{true};
+
+void stop(int)
+{
+  running = false;
+}
+
+/**
+ * @brief Print of all options can be selected via line command
+ */
+void printUsage()
+{
+  std::cout << std::endl;
+  std::cout << "Help";
+  std::cout << "\n\t--addr\t   [-a]  Address of the first board (default 127.0.0.2)";
+  std::cout << "\n\t--boards   [-n]  Number of boards (default 1)";
+  std::cout << "\n\t--host\t   [-d]  Address the samples are sent to (default 127.0.0.1)";
+  std::cout << "\n\t--port\t   [-p]  TCP and UDP port of the boards and of the host (default 64321)";
+  std::cout << "\n\t--rate\t   [-r]  Initial stream rate in half milliseconds, 0 to wait for the host (default 0)"
+            << std::endl;
+}
+
+static const struct option longOpts[] = {
+{ "addr", required_argument, NULL, 'a' },
+{ "boards", required_argument, NULL, 'n' },
+{ "host", required_argument, NULL, 'd' },
+{ "port", required_argument, NULL, 'p' },
+{ "rate", required_argument, NULL, 'r' },
+{ "help", no_argument, NULL, 'h' },
+{ NULL, no_argument, NULL, 0 }
+};
+
+struct OptionArgument
+{
+  std::string address = "127.0.0.2";
+  unsigned boards = 1;
+  std::string host = "127.0.0.1";
+  uint16_t port = 64321;
+  uint32_t rate = 0;
+  bool helpOption = false;
+} optionArgument;
+
+/**
+ * @brief State and threads of a simulated board
+ */
+class SimulatedBoard
+{
+public:
+  SimulatedBoard(uint32_t address_, unsigned index_) :
+    address(address_), index(index_), policy(SampleStreamPolicy_OFF), rate(0), sent(0)
+  {
+    for (unsigned row = 0; row < 6; ++row)
+      for (unsigned column = 0; column < 6; ++column)
+        matrix[row][column] = (row == column) ? 1.f : 0.f;
+    memset(offsets, 0, sizeof(offsets));
+    memset(bias, 0, sizeof(bias));
+    memset(inventory, 0, sizeof(inventory));
+    inventory[3] = index;
+  }
+
+  bool start()
+  {
+    if (optionArgument.rate > 0)
+    {
+      policy = SampleStreamPolicy_NORMAL;
+      rate = optionArgument.rate;
+    }
+    if (!openSockets())
+      return false;
+    commandThread = std::thread{&SimulatedBoard::serveCommands, this};
+    streamThread = std::thread{&SimulatedBoard::stream, this};
+    return true;
+  }
+
+  void join()
+  {
+    if (commandThread.joinable())
+      commandThread.join();
+    if (streamThread.joinable())
+      streamThread.join();
+    close(listenSocket);
+    close(udpSocket);
+  }
+
+  uint64_t getSent() const  {    return sent.load();  }
+
+private:
+  bool openSockets()
+  {
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(optionArgument.port);
+    local.sin_addr.s_addr = address;
+    int reuse = 1;
+
+    listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(listenSocket, (struct sockaddr*) &local, sizeof(local)) != 0 || listen(listenSocket, 1) != 0)
+    {
+      std::cerr << "TCP bind() failed for board " << index << "! Error code: " << errno << std::endl;
+      return false;
+    }
+
+    udpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    setsockopt(udpSocket, SOL_SOCKET, SO_BROADCAST, &reuse, sizeof(reuse));
+    if (bind(udpSocket, (struct sockaddr*) &local, sizeof(local)) != 0)
+    {
+      std::cerr << "UDP bind() failed for board " << index << "! Error code: " << errno << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  template <typename Message>
+  void reply(int connection, const Message& message)
+  {
+    uint8_t buffer[Ethservice::PACKET_MAX_SIZE];
+    auto size = encode(message, buffer, sizeof(buffer));
+    if (size > 0 && ::send(connection, buffer, size, MSG_NOSIGNAL) != size)
+      std::cerr << "send() failed for board " << index << "! Error code: " << errno << std::endl;
+  }
+
+  /**
+   * @brief Executes a command and sends its reply, if any
+   */
+  void execute(int connection, const uint8_t* message, size_t size)
+  {
+    LIBHeader header;
+    decode(header, message, size);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    switch (header.getId())
+    {
+    case MESSAGE_ID__GET_BOARD_INFO:
+    {
+      ReplyBoardInfo rpl;
+      rpl.setRelease(PROTOCOLVERSION_RELEASE);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__CALIBRATE_OFFSETS:
+    {
+      // the next samples are unbiased
+      for (unsigned i = 0; i < 6; ++i)
+        bias[i] = value(i);
+      ReplyCalibrateOffsets rpl;
+      rpl.setBrc(BoardReturnCode_OK);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__SET_SAMPLE_STREAM_POLICY:
+    {
+      SetSampleStreamPolicy set;
+      decode(set, message, size);
+      ReplySetSampleStreamPolicy rpl;
+      bool valid = set.getPolicy() == SampleStreamPolicy_OFF || set.getRate() > 0;
+      if (valid)
+      {
+        policy = set.getPolicy();
+        rate = set.getRate();
+      }
+      rpl.setBrc(valid ? BoardReturnCode_OK : BoardReturnCode_ERR);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_SAMPLE_STREAM_POLICY:
+    {
+      ReplyGetSampleStreamPolicy rpl;
+      rpl.setPolicy(policy);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__SET_CALIBRATION_MATRIX_ROW:
+    {
+      SetCalibrationMatrixRow set;
+      decode(set, message, size);
+      ReplySetCalibrationMatrixRow rpl;
+      rpl.setBrc(set.getRow() < 6 ? BoardReturnCode_OK : BoardReturnCode_ERR);
+      if (set.getRow() < 6)
+        memcpy(matrix[set.getRow()], set.getCoefficients(), sizeof(matrix[0]));
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_CALIBRATION_MATRIX_ROW:
+    {
+      GetCalibrationMatrixRow get;
+      decode(get, message, size);
+      ReplyGetCalibrationMatrixRow rpl;
+      rpl.setRow(get.getRow());
+      rpl.setCoefficients(matrix[get.getRow() % 6]);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_CALIBRATION_OFFSETS:
+    {
+      ReplyGetCalibrationOffsets rpl;
+      rpl.setC0(offsets[0]); rpl.setC1(offsets[1]); rpl.setC2(offsets[2]);
+      rpl.setC3(offsets[3]); rpl.setC4(offsets[4]); rpl.setC5(offsets[5]);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_IP_ADDRESS:
+    {
+      ReplyGetIpAddress rpl;
+      rpl.setIpAddress(ntohl(address));
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_NETMASK:
+    {
+      ReplyGetNetmask rpl;
+      rpl.setNetmask(0xffffff00);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_GATEWAY:
+    {
+      ReplyGetGateway rpl;
+      rpl.setGateway(ntohl(address) & 0xffffff00);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__SET_MAC_ADDRESS:
+    {
+      ReplySetMacAddress rpl;
+      rpl.setMacrc(MacAddressReturnCode_OK);
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__GET_MAC_ADDRESS:
+    {
+      ReplyGetMacAddress rpl;
+      rpl.setM0(0x02); rpl.setM5(static_cast<uint8_t>(index));
+      reply(connection, rpl);
+      break;
+    }
+    case MESSAGE_ID__SAVE_INVENTORY_DATA_ON_FLASH:
+    {
+      SaveInventoryDataOnFlash set;
+      decode(set, message, size);
+      uint32_t data[5] = {set.getDesignCode(), set.getBoardVer(), set.getBoardRev(),
+                          set.getSerialNumber(), set.getDateTime()};
+      memcpy(inventory, data, sizeof(data));
+      break;
+    }
+    case MESSAGE_ID__LOAD_INVENTORY_DATA_FROM_FLASH:
+    {
+      ReplyLoadInventoryDataFromFlash rpl;
+      rpl.setDesignCode(inventory[0]); rpl.setBoardVer(inventory[1]); rpl.setBoardRev(inventory[2]);
+      rpl.setSerialNumber(inventory[3]); rpl.setDateTime(inventory[4]);
+      reply(connection, rpl);
+      break;
+    }
+    default:
+      // commands without reply (network settings, flash) are accepted and ignored
+      break;
+    }
+  }
+
+  /**
+   * @brief Command Thread: serves one host connection at a time
+   */
+  void serveCommands()
+  {
+    while (running)
+    {
+      struct timeval tv = {0, 100000};
+      fd_set readset;
+      FD_ZERO(&readset);
+      FD_SET(listenSocket, &readset);
+      if (select(listenSocket + 1, &readset, NULL, NULL, &tv) <= 0)
+        continue;
+
+      int connection = accept(listenSocket, NULL, NULL);
+      if (connection < 0)
+        continue;
+
+      uint8_t stream[2 * Ethservice::PACKET_MAX_SIZE];
+      size_t buffered = 0;
+      while (running)
+      {
+        tv.tv_sec = 0;
+        tv.tv_usec = 100000;
+        FD_ZERO(&readset);
+        FD_SET(connection, &readset);
+        if (select(connection + 1, &readset, NULL, NULL, &tv) <= 0)
+          continue;
+        auto received = ::recv(connection, stream + buffered, sizeof(stream) - buffered, 0);
+        if (received <= 0)
+          break;
+        buffered += received;
+
+        size_t offset = 0;
+        while (buffered - offset >= 4)
+        {
+          uint32_t word;
+          memcpy(&word, stream + offset, sizeof(word));
+          Codec::wordsToLittleEndian(&word, 1);
+          size_t size = Codec::unpackHeader(word).getSize();
+          if (size < 4 || size > Ethservice::PACKET_MAX_SIZE)
+          {
+            offset = buffered;
+            break;
+          }
+          if (buffered - offset < size)
+            break;
+          execute(connection, stream + offset, size);
+          offset += size;
+        }
+        memmove(stream, stream + offset, buffered - offset);
+        buffered -= offset;
+      }
+      close(connection);
+
+      // as the real board, stop streaming when the host goes away
+      std::lock_guard<std::mutex> lock(mutex);
+      policy = SampleStreamPolicy_OFF;
+    }
+  }
+
+  /**
+   * @brief Simulated load in thousandths of N and Nm, before the calibration offsets
+   */
+  float value(unsigned channel) const
+  {
+    double phase = (sent.load() + 1) * 0.0005 * (rate ? rate : 1);
+    return static_cast<float>(1000.0 * ((channel == 2 ? 20.0 : 1.0) + std::sin(2 * M_PI * (0.5 + 0.1 * channel) * phase)));
+  }
+
+  /**
+   * @brief Stream Thread: broadcasts a sample every rate half milliseconds
+   */
+  void stream()
+  {
+    struct sockaddr_in host;
+    memset(&host, 0, sizeof(host));
+    host.sin_family = AF_INET;
+    host.sin_port = htons(optionArgument.port);
+    host.sin_addr.s_addr = inet_addr(optionArgument.host.c_str());
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (running)
+    {
+      uint32_t period;
+      BCastSensorData data;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        period = (policy == SampleStreamPolicy_NORMAL) ? rate : 0;
+        if (period)
+        {
+          // force and torque, then raw channels
+          float values[12];
+          for (unsigned i = 0; i < 6; ++i)
+          {
+            values[i + 6] = value(i);
+            values[i] = values[i + 6] - bias[i];
+          }
+          data.setValues(values);
+        }
+      }
+
+      if (period)
+      {
+        uint8_t buffer[Ethservice::PACKET_MAX_SIZE];
+        auto size = encode(data, buffer, sizeof(buffer));
+        if (sendto(udpSocket, buffer, size, 0, (struct sockaddr*) &host, sizeof(host)) == size)
+          sent++;
+      }
+
+      // absolute deadlines, so that the rate does not drift with the send time
+      long step = (period ? period : 20) * 500000L;
+      next.tv_nsec += step;
+      while (next.tv_nsec >= 1000000000L)
+      {
+        next.tv_nsec -= 1000000000L;
+        next.tv_sec++;
+      }
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    }
+  }
+
+  const uint32_t address;
+  const unsigned index;
+  std::mutex mutex;
+  SampleStreamPolicy policy;
+  uint32_t rate;
+  float matrix[6][6];
+  uint32_t offsets[6];
+  float bias[6];
+  uint32_t inventory[5];
+  std::atomic<uint64_t> sent;
+  int listenSocket = -1;
+  int udpSocket = -1;
+  std::thread commandThread;
+  std::thread streamThread;
+};
+
+/**
+ * @brief This function checks the arguments of the command line
+ * @return 0 if no errors, otherwise -1 in case of errors.
+ */
+int checkArguments(int argc, char *argv[])
+{
+  int longIndex;
+  while (1)
+  {
+    auto opt = getopt_long(argc, argv, "a:n:d:p:r:h", longOpts, &longIndex);
+    if (opt == -1)
+      break;
+    switch (opt)
+    {
+    case 'a':
+      optionArgument.address = optarg;
+      break;
+    case 'n':
+      optionArgument.boards = strtoul(optarg, NULL, 10);
+      break;
+    case 'd':
+      optionArgument.host = optarg;
+      break;
+    case 'p':
+      optionArgument.port = static_cast<uint16_t>(strtoul(optarg, NULL, 10));
+      break;
+    case 'r':
+      optionArgument.rate = strtoul(optarg, NULL, 10);
+      break;
+    case 'h':   /* fall-through is intentional */
+    case '?':
+    default:
+      optionArgument.helpOption = true;
+      break;
+    }
+  }
+  return (optionArgument.boards > 0 && inet_addr(optionArgument.address.c_str()) != INADDR_NONE) ? 0 : -1;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+  if (checkArguments(argc, argv) != 0 || optionArgument.helpOption)
+  {
+    printUsage();
+    return optionArgument.helpOption ? 0 : -1;
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  std::vector<std::unique_ptr<SimulatedBoard>> boards;
+  uint32_t first = ntohl(inet_addr(optionArgument.address.c_str()));
+  for (unsigned i = 0; i < optionArgument.boards; ++i)
+  {
+    boards.emplace_back(new SimulatedBoard(htonl(first + i), i));
+    if (!boards.back()->start())
+    {
+      running = false;
+      break;
+    }
+  }
+  if (running)
+  {
+    struct in_addr last;
+    last.s_addr = htonl(first + optionArgument.boards - 1);
+    std::cout << optionArgument.boards << " AME boards simulated from " << optionArgument.address
+              << " to " << inet_ntoa(last) << ", port " << optionArgument.port << std::endl;
+  }
+
+  uint64_t lastSent = 0;
+  while (running)
+  {
+    sleep(1);
+    uint64_t total = 0;
+    for (auto& board : boards)
+      total += board->getSent();
+    std::cout << "samples/s: " << total - lastSent << std::endl;
+    lastSent = total;
+  }
+
+  for (auto& board : boards)
+    board->join();
+  return 0;
+}
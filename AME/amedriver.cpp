@@ -11,48 +11,25 @@
 #include "amedriver.h"
 
 #include <sstream>
+#include <yarp/os/LogStream.h>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 using namespace Ethservice;
 using namespace Multitorque;
 
-
-struct OptionArgument
-{
-  //addr
-  bool addrOption = false;
-  std::string ipAddress = "192.168.111.254";
-  std::string deviceAddress = "192.168.111.1";
-
-
-} optionArgument;
-
-/**
- * @brief This function allow the connction from pc to board
- * @return shared pointer of FtSensorNew class
- */
-std::shared_ptr<rehab::FtSensorNew> connectSensor()
-{
-
-  //Device Connection
-  //TODO FIX IT this static is shit
-  static auto bdm2= std::make_shared<Ethservice::EthInterfaceManager>(optionArgument.ipAddress,64321);
-  auto ftBoard = bdm2->addBoard(optionArgument.deviceAddress, true, 64321, true, 64321);
-  auto rc = bdm2->connectAll();
-  if ( !rehab::isRCOk(rc) )
-  {
-    exit(-1);
-  }
-  auto ftSensor =  std::make_shared<rehab::FtSensorNew>(bdm2.get(), ftBoard);
-  bdm2->startRecvThread();
-  return ftSensor;
-}
+// Port of the AME boards, used both locally and on the boards
+static constexpr int amePort = 64321;
 
 /**
  * @brief Yarp constructor
  */
 yarp::dev::amedriver::amedriver(): m_sensorReadings(6),
-                                                                 m_status(yarp::dev::IAnalogSensor::AS_OK)
+                                                                 m_status(yarp::dev::IAnalogSensor::AS_OK),
+                                                                 m_timedOut(false),
+                                                                 m_rawChannels(false),
+                                                                 m_board(-1)
 {
     yInfo("Constructor beggining.");
     // We fill the sensor readings only once in the constructor in this example
@@ -82,22 +59,90 @@ bool yarp::dev::amedriver::open(yarp::os::Searchable &config)
     yDebug("amedriver: opening");
     std::lock_guard<std::mutex> guard(m_mutex);
 
+    // Stream period in ms, sent to the board in half milliseconds
+    double streamPeriod = config.check("streamPeriod", yarp::os::Value(5.0),
+                                       "Period of the samples broadcast by the board (ms, multiple of 0.5)").asFloat64();
+    long streamRate = std::lround(streamPeriod * 2);
+    if (std::abs(streamRate - streamPeriod * 2) > 1e-6
+        || streamRate < static_cast<long>(rehab::FtSensorNew::MIN_STREAM_RATE)
+        || streamRate > static_cast<long>(rehab::FtSensorNew::MAX_STREAM_RATE))
+    {
+        yError("amedriver: streamPeriod %g ms is not a multiple of 0.5 ms in the supported range [%g, %g] ms", streamPeriod,
+               rehab::FtSensorNew::MIN_STREAM_RATE / 2.0, rehab::FtSensorNew::MAX_STREAM_RATE / 2.0);
+        return false;
+    }
+
+    // Age of the last sample after which the sensor is in timeout
+    int maxSampleAge = config.check("maxSampleAge", yarp::os::Value(static_cast<int>(rehab::FtSensorNew::DEFAULT_MAX_SAMPLE_AGE.count())),
+                                    "Age of the last sample after which the sensor is in timeout (ms)").asInt32();
+    if (maxSampleAge <= streamPeriod)
+    {
+        yError("amedriver: maxSampleAge %d ms must be longer than streamPeriod %g ms", maxSampleAge, streamPeriod);
+        return false;
+    }
+
+    // Optional raw channels published after force and torque
+    m_rawChannels = config.check("rawChannels", yarp::os::Value(false),
+                                 "Publish the raw channels after force and torque").asBool();
+    m_sensorReadings.resize(m_rawChannels ? rehab::FtSensorNew::SAMPLE_VALUES : rehab::FtSensorNew::FT_SENSOR_AXIS, 0.0);
+
+    // Scale factors of force and torque
+    calibFactor.resize(rehab::FtSensorNew::FT_SENSOR_AXIS, 1.0);
+    if (config.check("calibFactor"))
+    {
+        yarp::os::Bottle *factors = config.find("calibFactor").asList();
+        if (!factors || factors->size() != rehab::FtSensorNew::FT_SENSOR_AXIS)
+        {
+            yError("amedriver: calibFactor must be a list of %zu values", rehab::FtSensorNew::FT_SENSOR_AXIS);
+            return false;
+        }
+        for (size_t i = 0; i < rehab::FtSensorNew::FT_SENSOR_AXIS; ++i)
+            calibFactor[i] = factors->get(i).asFloat64();
+    }
+
     string IpAddress=config.findGroup("ipAddress").tail().get(0).asString().c_str();
     vector<string> list;
     list = Ethservice::getIpAddress();
-    optionArgument.ipAddress = Ethservice::searchAddressOnList(IpAddress,list);
-    if (optionArgument.ipAddress== "")
+    string localAddress = Ethservice::searchAddressOnList(IpAddress,list);
+    if (localAddress== "")
     {
-         yError("Constructor beggining.");
-      std::cerr << "ipAddress ["  << IpAddress << "]" << " no matching" << std::endl;
+      yError("amedriver: ipAddress [%s] no matching local interface", IpAddress.c_str());
       return false;
     }
-    optionArgument.deviceAddress=IpAddress;
-    optionArgument.addrOption = true;
 
-    
-   ft = connectSensor();
-   ft->setSampleStreamPol(Multitorque::SampleStreamPolicy_NORMAL, 10);
+    // All the sensors reached through the same interface share the manager,
+    // with its socket and receive thread
+    m_manager = Ethservice::EthInterfaceManager::acquire(localAddress, amePort);
+    m_board = m_manager->addBoard(IpAddress, true, amePort, true, amePort);
+    if ( !rehab::isRCOk(m_manager->connectAll()) )
+    {
+      yError("amedriver: connection to %s failed", IpAddress.c_str());
+      m_manager->removeBoard(m_board);
+      m_manager.reset();
+      return false;
+    }
+   int historySize = config.check("historySize", yarp::os::Value(static_cast<int>(rehab::FtSensorNew::DEFAULT_HISTORY_SIZE)),
+                                  "Number of samples kept for the history reads").asInt32();
+   ft = std::make_shared<rehab::FtSensorNew>(m_manager.get(), m_board, historySize > 0 ? historySize : 1);
+   ft->setMaxSampleAge(std::chrono::milliseconds(maxSampleAge));
+
+   // Called by the receive thread while the board is silent: reported once, until it streams again
+   m_manager->installTimeoutHandler(m_board, [this, IpAddress](board_id_t) {
+     if (ft && !ft->isConnectivityOk() && !m_timedOut.exchange(true))
+       yWarning("amedriver: no samples from %s since %g ms", IpAddress.c_str(), ft->getLiveness().lastSampleAge * 1000);
+   });
+   m_manager->startRecvThread();
+
+   Multitorque::SampleStreamPolicy policy;
+   if (ft->setSampleStreamPol(Multitorque::SampleStreamPolicy_NORMAL, streamRate) != 0
+       || ft->getSampleStreamPol(policy) != 0 || policy != Multitorque::SampleStreamPolicy_NORMAL)
+   {
+      yError("amedriver: %s did not start streaming at %g ms", IpAddress.c_str(), streamPeriod);
+      m_manager->removeBoard(m_board);
+      ft.reset();
+      m_manager.reset();
+      return false;
+   }
 
  return true;
 }
@@ -107,8 +152,12 @@ bool yarp::dev::amedriver::close()
     std::lock_guard<std::mutex> guard(m_mutex);
    //TODO how to close assuring socket gets closed daq.close();
     // Is this enough?
+    if (!ft)
+        return true;
     ft->setSampleStreamPol(Multitorque::SampleStreamPolicy_OFF, 0);
+    m_manager->removeBoard(m_board);
     ft.reset();
+    m_manager.reset();
     return true;
 }
 
@@ -120,22 +169,38 @@ yarp::dev::amedriver::amedriver(const yarp::dev::amedriver& /*other*/)
 
 int yarp::dev::amedriver::read(yarp::sig::Vector &out)
 {
-    rehab::FtSensorNew::FTSensorData ftc2;
-     ft->getFTData(ftc2);
-
-     m_sensorReadings[0] =  (double) ftc2[0];
-      m_sensorReadings[1] = (double) ftc2[1];
-      m_sensorReadings[2] = (double) ftc2[2];
+    rehab::FtSensorNew::TimedSample sample;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!ft)
+        return yarp::dev::IAnalogSensor::AS_ERROR;
+    if (ft->getLatestSample(sample) == 0)
+    {
+      // Force and torque on x,y,z axis, from thousandths of N and Nm
+      for (size_t i = 0; i < rehab::FtSensorNew::FT_SENSOR_AXIS; ++i)
+        m_sensorReadings[i] = sample.values[i] / 1000.0 * calibFactor[i];
 
-      // Set torque on x,y,z axis
-      m_sensorReadings[3] = (double) ftc2[3];;
-      m_sensorReadings[4] = (double) ftc2[4];;
-      m_sensorReadings[5] = (double) ftc2[5];
+      for (size_t i = rehab::FtSensorNew::FT_SENSOR_AXIS; i < m_sensorReadings.size(); ++i)
+        m_sensorReadings[i] = sample.values[i];
 
-      m_timestamp.update();
+      m_timestamp = yarp::os::Stamp(static_cast<int>(sample.sequence), sample.timestamp);
+    }
       out = m_sensorReadings;
 
-      return m_status;
+      return currentState();
+}
+
+/**
+ * @brief State of the sensor, in timeout when its last sample is stale. Called with m_mutex locked
+ */
+int yarp::dev::amedriver::currentState()
+{
+    if (!ft)
+        return m_status;
+    if (!ft->isConnectivityOk())
+        return yarp::dev::IAnalogSensor::AS_TIMEOUT;
+    if (m_timedOut.exchange(false))
+        yInfo("amedriver: samples received again");
+    return m_status;
 }
 
 
@@ -146,12 +211,12 @@ int yarp::dev::amedriver::getState(int /*ch*/)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
         yDebug("checking state");
-    return m_status;
+    return currentState();
 }
 
 int yarp::dev::amedriver::getChannels()
 {
-    return 6;
+    return m_sensorReadings.size();
 }
 
 int yarp::dev::amedriver::calibrateSensor()
@@ -184,8 +249,36 @@ int yarp::dev::amedriver::calibrateChannel(int /*ch*/, double /*v*/)
 
 yarp::os::Stamp yarp::dev::amedriver::getLastInputStamp()
 {
+    std::lock_guard<std::mutex> guard(m_mutex);
     return m_timestamp;
 }
 
+uint64_t yarp::dev::amedriver::readHistory(uint64_t &cursor, std::vector<yarp::sig::Vector> &samples,
+                                           std::vector<yarp::os::Stamp> &stamps)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!ft)
+        return 0;
+    std::vector<rehab::FtSensorNew::TimedFTData> history;
+    uint64_t lost = ft->getFTHistory(cursor, history);
+    for (const auto& sample : history)
+    {
+        yarp::sig::Vector values(rehab::FtSensorNew::FT_SENSOR_AXIS);
+        for (size_t i = 0; i < rehab::FtSensorNew::FT_SENSOR_AXIS; ++i)
+            values[i] = sample.ftData[i] * calibFactor[i];
+        samples.push_back(values);
+        stamps.push_back(yarp::os::Stamp(static_cast<int>(sample.sequence), sample.timestamp));
+    }
+    return lost;
+}
+
+rehab::FtSensorNew::Liveness yarp::dev::amedriver::getLiveness()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!ft)
+        return rehab::FtSensorNew::Liveness{false, std::numeric_limits<double>::infinity(), 0, 0};
+    return ft->getLiveness();
+}
+
 
 
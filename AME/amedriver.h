@@ -45,7 +45,8 @@ private:
     // Use a mutex to avoid race conditions
     std::mutex m_mutex;
 
-    // Buffers of sensor data and timestamp
+    // Buffers of sensor data and timestamp: the time at which the sample has been received
+    // and, as count, its number
     yarp::sig::Vector m_sensorReadings;
     yarp::os::Stamp m_timestamp;
 
@@ -55,12 +56,24 @@ private:
     // Status of the sensor
     int m_status;
 
+    // Set by the timeout handler when the board stops streaming, cleared once it streams again
+    std::atomic<bool> m_timedOut;
+
+    // Publish the raw channels after force and torque
+    bool m_rawChannels;
+
+    // Manager shared with the other sensors on the same interface, and board of this sensor
+    std::shared_ptr<Ethservice::EthInterfaceManager> m_manager;
+    board_id_t m_board;
+
    // Pointer for the ftSensor class
     shared_ptr<rehab::FtSensorNew> ft;
 
-    //Vector to store calibration factor
+    //Vector to store calibration factor, applied to force and torque
     yarp::sig::Vector calibFactor;
 
+    int currentState();
+
 public:
     amedriver();
     virtual ~amedriver();
@@ -80,6 +93,24 @@ public:
 
     // IPreciselyTimed interface
     virtual yarp::os::Stamp getLastInputStamp();
+
+    /**
+     * Read the samples received since the previous call, oldest first
+     * @param[in,out] cursor number of the last sample read, 0 at the first call
+     * @param[out] samples force and torque of the samples, without the raw channels
+     *             even when rawChannels is set
+     * @param[out] stamps receive time and number of the samples
+     * @return number of samples lost, because more than historySize samples have been received
+     *         since the previous call, 0 if the device is closed
+     */
+    uint64_t readHistory(uint64_t &cursor, std::vector<yarp::sig::Vector> &samples,
+                         std::vector<yarp::os::Stamp> &stamps);
+
+    /**
+     * Liveness of the board, for monitoring
+     * @return age of the last sample, observed rate and deadlines missed by the board
+     */
+    rehab::FtSensorNew::Liveness getLiveness();
 };
 
 }
@@ -16,6 +16,11 @@ namespace
   int32_t decode32BitValue(uint8_t* value,const  uint8_t* binary);
   int32_t decode64BitValue(uint8_t* value, const uint8_t* binary);
 
+  template <typename T>
+  int32_t encodeWords(const T* values, const size_t count, uint8_t* binary, const size_t maxSize);
+  template <typename T>
+  int32_t decodeWords(T* values, const size_t count, const uint8_t* binary, const size_t maxSize);
+
 }
 
 namespace LIB
@@ -167,35 +172,77 @@ int32_t decode(double& value, const uint8_t* binary, const size_t maxSize)
   return decode64BitValue((uint8_t*)(&value), binary);
 }
 
+// Arrays
+int32_t encodeArray(const float* values, const size_t count, uint8_t* binary, const size_t maxSize)
+{
+  return encodeWords(values, count, binary, maxSize);
+}
+
+int32_t encodeArray(const int32_t* values, const size_t count, uint8_t* binary, const size_t maxSize)
+{
+  return encodeWords(values, count, binary, maxSize);
+}
+
+int32_t encodeArray(const uint32_t* values, const size_t count, uint8_t* binary, const size_t maxSize)
+{
+  return encodeWords(values, count, binary, maxSize);
+}
+
+int32_t decodeArray(float* values, const size_t count, const uint8_t* binary, const size_t maxSize)
+{
+  return decodeWords(values, count, binary, maxSize);
+}
+
+int32_t decodeArray(int32_t* values, const size_t count, const uint8_t* binary, const size_t maxSize)
+{
+  return decodeWords(values, count, binary, maxSize);
+}
+
+int32_t decodeArray(uint32_t* values, const size_t count, const uint8_t* binary, const size_t maxSize)
+{
+  return decodeWords(values, count, binary, maxSize);
+}
+
 } // namespace LIB
 
 // Private functions
 namespace
 {
+  // The values are copied through integers, as neither value nor binary may be aligned;
+  // the 8 and 16 bit values fill the low bytes of their word, the others are zero
   int32_t encode8BitValue(const uint8_t* value, uint8_t* binary)
   {
-    binary[0] = *value;
+    uint32_t word = *value;
+    _32BIT_TO_LITTLE_ENDIAN(word);
+    memcpy(binary, &word, 4);
     return 4;
   }
 
   int32_t encode16BitValue(const uint8_t* value, uint8_t* binary)
   {
-    _16BIT_TO_LITTLE_ENDIAN(value);
-    memcpy(binary, value, 2);
+    uint16_t halfWord;
+    memcpy(&halfWord, value, 2);
+    uint32_t word = halfWord;
+    _32BIT_TO_LITTLE_ENDIAN(word);
+    memcpy(binary, &word, 4);
     return 4;
   }
 
   int32_t encode32BitValue(const uint8_t* value, uint8_t* binary)
   {
-    _32BIT_TO_LITTLE_ENDIAN(value);
-    memcpy(binary, value, 4);
+    uint32_t word;
+    memcpy(&word, value, 4);
+    _32BIT_TO_LITTLE_ENDIAN(word);
+    memcpy(binary, &word, 4);
     return 4;
   }
 
   int32_t encode64BitValue(const uint8_t* value, uint8_t* binary)
   {
-    _64BIT_TO_LITTLE_ENDIAN(value);
-    memcpy(binary, value, 8);
+    uint64_t doubleWord;
+    memcpy(&doubleWord, value, 8);
+    _64BIT_TO_LITTLE_ENDIAN(doubleWord);
+    memcpy(binary, &doubleWord, 8);
     return 8;
   }
 
@@ -207,22 +254,57 @@ namespace
 
   int32_t decode16BitValue(uint8_t* value, const uint8_t* binary)
   {
-    memcpy(value, binary, 2);
-    _16BIT_FROM_LITTLE_ENDIAN(value);
+    uint16_t halfWord;
+    memcpy(&halfWord, binary, 2);
+    _16BIT_FROM_LITTLE_ENDIAN(halfWord);
+    memcpy(value, &halfWord, 2);
     return 4;
   }
 
   int32_t decode32BitValue(uint8_t* value, const uint8_t* binary)
   {
-    memcpy(value, binary, 4);
-    _32BIT_FROM_LITTLE_ENDIAN(value);
+    uint32_t word;
+    memcpy(&word, binary, 4);
+    _32BIT_FROM_LITTLE_ENDIAN(word);
+    memcpy(value, &word, 4);
     return 4;
   }
 
   int32_t decode64BitValue(uint8_t* value, const uint8_t* binary)
   {
-    memcpy(value, binary, 8);
-    _64BIT_FROM_LITTLE_ENDIAN(value);
+    uint64_t doubleWord;
+    memcpy(&doubleWord, binary, 8);
+    _64BIT_FROM_LITTLE_ENDIAN(doubleWord);
+    memcpy(value, &doubleWord, 8);
     return 8;
   }
+
+  // On a little endian host the array is already in its wire format: a single copy
+  template <typename T>
+  int32_t encodeWords(const T* values, const size_t count, uint8_t* binary, const size_t maxSize)
+  {
+    static_assert(sizeof(T) == 4, "Arrays are encoded as 32 bit words");
+    CHECK_BUFFER_SIZE(maxSize, 4 * count)
+#ifdef LIB_HOST_BIG_ENDIAN
+    for(size_t i = 0; i < count; ++i)
+      encode32BitValue((const uint8_t*)(values + i), binary + 4 * i);
+#else
+    memcpy(binary, values, 4 * count);
+#endif
+    return (int32_t)(4 * count);
+  }
+
+  template <typename T>
+  int32_t decodeWords(T* values, const size_t count, const uint8_t* binary, const size_t maxSize)
+  {
+    static_assert(sizeof(T) == 4, "Arrays are decoded from 32 bit words");
+    CHECK_BUFFER_SIZE(maxSize, 4 * count)
+#ifdef LIB_HOST_BIG_ENDIAN
+    for(size_t i = 0; i < count; ++i)
+      decode32BitValue((uint8_t*)(values + i), binary + 4 * i);
+#else
+    memcpy(values, binary, 4 * count);
+#endif
+    return (int32_t)(4 * count);
+  }
 }
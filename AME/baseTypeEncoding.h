@@ -1,6 +1,7 @@
 #ifndef LIBCPPBASETYPEENCODER_32BITALIGNED_H_INCLUDED
 #define LIBCPPBASETYPEENCODER_32BITALIGNED_H_INCLUDED
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define CHECK_BUFFER_SIZE(maxSize, requestedSize) \
@@ -9,16 +10,23 @@
       return -1; \
   } while(0);
 
-#ifdef BIG_ENDIAN
+// Byte order of the host, from the compiler: the BIG_ENDIAN macro of <endian.h> is defined
+// on every host (as the value compared with BYTE_ORDER), so it can not be tested alone
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  #define LIB_HOST_BIG_ENDIAN
+#endif
+
+// Conversion in place of an unsigned integer of the matching size
+#ifdef LIB_HOST_BIG_ENDIAN
   #include <byteswap.h>
 
-  #define _16BIT_TO_LITTLE_ENDIAN(x)  *x = bswap_16(*x);
-  #define _32BIT_TO_LITTLE_ENDIAN(x)  *x = bswap_32(*x);
-  #define _64BIT_TO_LITTLE_ENDIAN(x)  *x = bswap_64(*x);
+  #define _16BIT_TO_LITTLE_ENDIAN(x)  x = bswap_16(x);
+  #define _32BIT_TO_LITTLE_ENDIAN(x)  x = bswap_32(x);
+  #define _64BIT_TO_LITTLE_ENDIAN(x)  x = bswap_64(x);
 
-  #define _16BIT_FROM_LITTLE_ENDIAN(x)  *x = bswap_16(*x);
-  #define _32BIT_FROM_LITTLE_ENDIAN(x)  *x = bswap_32(*x);
-  #define _64BIT_FROM_LITTLE_ENDIAN(x)  *x = bswap_64(*x);
+  #define _16BIT_FROM_LITTLE_ENDIAN(x)  x = bswap_16(x);
+  #define _32BIT_FROM_LITTLE_ENDIAN(x)  x = bswap_32(x);
+  #define _64BIT_FROM_LITTLE_ENDIAN(x)  x = bswap_64(x);
 #else
   #define _16BIT_TO_LITTLE_ENDIAN(x)
   #define _32BIT_TO_LITTLE_ENDIAN(x)
@@ -27,7 +35,7 @@
   #define _16BIT_FROM_LITTLE_ENDIAN(x)
   #define _32BIT_FROM_LITTLE_ENDIAN(x)
   #define _64BIT_FROM_LITTLE_ENDIAN(x)
-#endif // BIG_ENDIAN
+#endif // LIB_HOST_BIG_ENDIAN
 
 #define ENCODING_TYPE 0x1
 
@@ -60,6 +68,15 @@ int32_t decode(uint64_t& value, const uint8_t* binary, const size_t maxSize);
 int32_t decode(float& value, const uint8_t* binary, const size_t maxSize);
 int32_t decode(double& value, const uint8_t* binary, const size_t maxSize);
 
+// Arrays of 32 bit values, one word each: a single size check and copy for the whole array
+int32_t encodeArray(const float* values, const size_t count, uint8_t* binary, const size_t maxSize);
+int32_t encodeArray(const int32_t* values, const size_t count, uint8_t* binary, const size_t maxSize);
+int32_t encodeArray(const uint32_t* values, const size_t count, uint8_t* binary, const size_t maxSize);
+
+int32_t decodeArray(float* values, const size_t count, const uint8_t* binary, const size_t maxSize);
+int32_t decodeArray(int32_t* values, const size_t count, const uint8_t* binary, const size_t maxSize);
+int32_t decodeArray(uint32_t* values, const size_t count, const uint8_t* binary, const size_t maxSize);
+
 } // namespace LIB
 
 #endif // LIBCPPBASETYPEENCODER_32BITALIGNED_H_INCLUDED
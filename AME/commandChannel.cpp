@@ -0,0 +1,210 @@
+/**
+ * @file
+ * @version 1.0
+ *
+ * @copyright (c) IIT Fondazione Istituto Italiano
+ *            di Tecnologia. All rights reserved
+ *
+ * @brief Request/reply channel over the TCP connection of a board
+ */
+#include "commandChannel.h"
+#include "MultitorqueCodec.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+
+namespace rehab
+{
+
+using namespace Ethservice;
+
+/// Longest wait of the reader, bounding the time needed to stop it
+constexpr static std::chrono::milliseconds maxReaderWait{50};
+
+/**
+ * @brief Starts the reader of the TCP connection of the board
+ * @param board_ Connected board, kept alive (with its connection) by the channel
+ */
+CommandChannel::CommandChannel(std::shared_ptr<Board> board_) :
+  board{std::move(board_)}, continuing{true}, unexpectedReplies{0}
+{
+  if (board && board->hasTcpService())
+    readerThread = std::thread{&CommandChannel::reader, this};
+}
+
+/**
+ * @brief Stops the reader; the requests still pending get an empty reply
+ */
+CommandChannel::~CommandChannel()
+{
+  continuing = false;
+  if (readerThread.joinable())
+    readerThread.join();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto& request : pending)
+    request.reply.set_value(Reply{});
+  pending.clear();
+}
+
+/**
+ * @brief Sends a command without waiting for its reply
+ * @param command Encoded command
+ * @return Number of byte sent otherwise -1
+ */
+int32_t CommandChannel::send(const CharBuff& command)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return board ? board->sendTcp(&command) : -1;
+}
+
+/**
+ * @brief Sends a command and returns its future reply
+ * @param command Encoded command
+ * @param replyIds Ids of the messages accepted as reply
+ * @param timeout Time after which the reply is given up
+ * @param accepts Filter of the messages with the ids accepted, none to accept all of them
+ * @return Reply, empty (size 0) on timeout or if the command can not be sent
+ */
+std::future<CommandChannel::Reply> CommandChannel::request(const CharBuff& command,
+                                                           const std::vector<uint16_t>& replyIds,
+                                                           std::chrono::milliseconds timeout,
+                                                           ReplyFilter accepts)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // registered before sending, as the reply may come before send() returns
+  pending.emplace_back();
+  PendingRequest& request = pending.back();
+  request.replyIds = replyIds;
+  request.accepts = std::move(accepts);
+  request.deadline = std::chrono::steady_clock::now() + timeout;
+  std::future<Reply> reply = request.reply.get_future();
+
+  if (!board || !readerThread.joinable() || board->sendTcp(&command) < 0)
+  {
+    std::cerr << "CommandChannel: send failed! Error code:  "<< errno <<  std::endl;
+    request.reply.set_value(Reply{});
+    pending.pop_back();
+  }
+  return reply;
+}
+
+/**
+ * @brief Gives a message to the oldest request waiting for it and accepting it
+ * @param message Message, header included
+ * @param size Size of the message
+ */
+void CommandChannel::onMessage(const uint8_t* message, size_t size)
+{
+  uint32_t word;
+  memcpy(&word, message, sizeof(word));
+  Multitorque::Codec::wordsToLittleEndian(&word, 1);
+  uint16_t id = Multitorque::Codec::unpackHeader(word).getId();
+
+  Reply reply;
+  memcpy(reply.content, message, size);
+  reply.size = size;
+
+  // a late reply of an expired request must not be taken for the reply of the next one
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto request = pending.begin(); request != pending.end(); ++request)
+  {
+    if (std::find(request->replyIds.begin(), request->replyIds.end(), id) != request->replyIds.end()
+        && (!request->accepts || request->accepts(reply)))
+    {
+      request->reply.set_value(reply);
+      pending.erase(request);
+      return;
+    }
+  }
+  unexpectedReplies.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gives an empty reply to the requests past their deadline
+ * @return Time until the nearest deadline, at most maxReaderWait
+ */
+std::chrono::milliseconds CommandChannel::expireRequests()
+{
+  auto now = std::chrono::steady_clock::now();
+  auto wait = maxReaderWait;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto request = pending.begin(); request != pending.end(); )
+  {
+    if (request->deadline <= now)
+    {
+      request->reply.set_value(Reply{});
+      request = pending.erase(request);
+    }
+    else
+    {
+      wait = std::min(wait, std::chrono::duration_cast<std::chrono::milliseconds>(request->deadline - now)
+                      + std::chrono::milliseconds{1});
+      ++request;
+    }
+  }
+  return wait;
+}
+
+/**
+ * @brief Reader Thread: splits the TCP stream in messages, using the size in their header
+ */
+void CommandChannel::reader()
+{
+  // room for a partial message followed by a full read
+  uint8_t stream[2 * PACKET_MAX_SIZE];
+  size_t buffered = 0;
+
+  while (continuing)
+  {
+    struct pollfd descriptor;
+    descriptor.fd = board->getTcpSockId();
+    descriptor.events = POLLIN;
+    auto ready = poll(&descriptor, 1, expireRequests().count());
+    if (ready <= 0)
+      continue;
+
+    auto received = ::recv(descriptor.fd, stream + buffered, sizeof(stream) - buffered, 0);
+    if (received <= 0)
+    {
+      std::cerr << "CommandChannel: connection lost! Error code:  "<< errno <<  std::endl;
+      break;
+    }
+    buffered += received;
+
+    size_t offset = 0;
+    while (buffered - offset >= sizeof(uint32_t))
+    {
+      uint32_t word;
+      memcpy(&word, stream + offset, sizeof(word));
+      Multitorque::Codec::wordsToLittleEndian(&word, 1);
+      size_t size = Multitorque::Codec::unpackHeader(word).getSize();
+      if (size < sizeof(uint32_t) || size > PACKET_MAX_SIZE)
+      {
+        // not a header: the stream can not be split anymore, drop what has been received
+        std::cerr << "CommandChannel: invalid message size " << size << std::endl;
+        offset = buffered;
+        break;
+      }
+      if (buffered - offset < size)
+        break;
+      this->onMessage(stream + offset, size);
+      offset += size;
+    }
+    memmove(stream, stream + offset, buffered - offset);
+    buffered -= offset;
+  }
+
+  // from now on, the requests expire when the channel is destroyed
+  while (continuing)
+  {
+    std::this_thread::sleep_for(this->expireRequests());
+  }
+}
+
+}
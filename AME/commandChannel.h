@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @version 1.0
+ *
+ * @copyright (c) IIT Fondazione Istituto Italiano
+ *            di Tecnologia. All rights reserved
+ *
+ * @brief Request/reply channel over the TCP connection of a board
+ */
+
+#ifndef COMMANDCHANNEL_H_
+#define COMMANDCHANNEL_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ethService.h"
+
+namespace rehab
+{
+
+/**
+ * @brief Sends the commands of a board and gives back their replies.
+ *
+ *        A reader thread splits the TCP stream in messages and gives each one to the oldest
+ *        pending request waiting for its id (and accepting it, see ReplyFilter), so that
+ *        several commands can be in flight.
+ *        Every request has a deadline, after which its reply is empty.
+ *        Messages nobody waits for (e.g. replies of the commands sent with send()) are dropped.
+ */
+class CommandChannel final
+{
+public:
+  using Reply = Ethservice::CharBuff;
+  /// Tells if a message with one of the ids awaited is the reply of a request (e.g. the row
+  /// requested), called by the reader thread with the channel locked
+  using ReplyFilter = std::function<bool(const Reply&)>;
+
+  explicit CommandChannel(std::shared_ptr<Ethservice::Board> board_);
+  ~CommandChannel();
+
+  int32_t send(const Ethservice::CharBuff& command);
+  std::future<Reply> request(const Ethservice::CharBuff& command,
+                             const std::vector<uint16_t>& replyIds,
+                             std::chrono::milliseconds timeout,
+                             ReplyFilter accepts = ReplyFilter());
+
+  /**
+   * @brief Number of messages received while no request was waiting for them
+   */
+  uint64_t getUnexpectedReplies() const  {    return unexpectedReplies.load(std::memory_order_relaxed);  }
+
+private:
+  // Prevent copy
+  CommandChannel(const CommandChannel&) = delete;
+  CommandChannel& operator=(const CommandChannel&) = delete;
+
+  struct PendingRequest
+  {
+    std::vector<uint16_t> replyIds;
+    ReplyFilter accepts;
+    std::chrono::steady_clock::time_point deadline;
+    std::promise<Reply> reply;
+  };
+
+  void reader();
+  void onMessage(const uint8_t* message, size_t size);
+  std::chrono::milliseconds expireRequests();
+
+  std::shared_ptr<Ethservice::Board> board;
+  /// Protects the pending requests and orders their registration as their sending
+  std::mutex mutex;
+  std::list<PendingRequest> pending;
+  std::atomic<bool> continuing;
+  std::atomic<uint64_t> unexpectedReplies;
+  std::thread readerThread;
+};
+
+}
+
+#endif /* COMMANDCHANNEL_H_ */
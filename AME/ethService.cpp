@@ -15,8 +15,14 @@
 #include <arpa/inet.h>
 #include <errno.h>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
 #include <ifaddrs.h>
 #include <netinet/in.h>
+#include <string.h>
+#include <unistd.h>
 
 
 namespace Ethservice {
@@ -30,6 +36,16 @@ using namespace rehab;
 ///
 const static string udpBroadcastAddress = "255.255.255.255";
 
+/**
+ * @brief Key of a sender in the dispatch table
+ * @param ip Address in network byte order
+ * @param port Port in host byte order, 0 for any port
+ */
+static inline uint64_t senderKey(uint32_t ip, uint16_t port)
+{
+  return ((uint64_t)ip << 16) | port;
+}
+
 /**
    * @brief The destructor is not virtual because the class is Final
    *        and is meant not to be overriden
@@ -184,6 +200,7 @@ rehab::RC Board::connect(int udpSockId)
     }
   }
 
+  this->connected = (rc == RC::OK);
   return rc;
 }
 
@@ -194,19 +211,58 @@ rehab::RC Board::connect(int udpSockId)
  */
 void Board::installUdpDatagramHandler(udpMessageHandler_t&& msgHandle)
 {
-  this->msgh.emplace_back(msgHandle);
+  std::shared_ptr<HandlerList> handlers = std::make_shared<HandlerList>(*std::atomic_load(&this->msgh));
+  handlers->emplace_back(std::move(msgHandle));
+  std::atomic_store(&this->msgh, std::shared_ptr<const HandlerList>(std::move(handlers)));
 }
 
 /*!
  * \brief Gives the datagram to each of the Datagram Handler
  * \param datagram Buffer which contains the received message
+ * \param receiveTime Time at which the datagram has been received
  */
-void Board::onUdpDatagram(const CharBuff* datagram)
+void Board::onUdpDatagram(const CharBuff* datagram, receiveTime_t receiveTime)
 {
   // Gives the datagram to each of the Datagram Handler
-  for (auto&& udpHandlers : msgh)
+  std::shared_ptr<const HandlerList> handlers = std::atomic_load(&this->msgh);
+  for (auto&& udpHandlers : *handlers)
   {
-    udpHandlers(datagram);
+    udpHandlers(datagram, receiveTime);
+  }
+}
+
+/*!
+ * \brief Installs a handler called, from the receive thread, every timeout
+ *        of the manager during which nothing has been received from the board
+ * \param timeoutHandle Function that takes care of the timeout
+ */
+void Board::installTimeoutHandler(timeoutHandler_t&& timeoutHandle)
+{
+  std::shared_ptr<TimeoutHandlerList> handlers = std::make_shared<TimeoutHandlerList>(*std::atomic_load(&this->timeoutHandlers));
+  handlers->emplace_back(std::move(timeoutHandle));
+  std::atomic_store(&this->timeoutHandlers, std::shared_ptr<const TimeoutHandlerList>(std::move(handlers)));
+}
+
+/*!
+ * \brief Removes the datagram and timeout handlers of the board. The receive
+ *        thread may still be calling them until the end of its dispatch
+ */
+void Board::removeHandlers()
+{
+  std::atomic_store(&this->msgh, std::make_shared<const HandlerList>());
+  std::atomic_store(&this->timeoutHandlers, std::make_shared<const TimeoutHandlerList>());
+}
+
+/*!
+ * \brief Gives the timeout to each of the Timeout Handler
+ * \param boardId Identifier of the board in its manager
+ */
+void Board::onTimeout(board_id_t boardId)
+{
+  std::shared_ptr<const TimeoutHandlerList> handlers = std::atomic_load(&this->timeoutHandlers);
+  for (auto&& timeoutHandler : *handlers)
+  {
+    timeoutHandler(boardId);
   }
 }
 
@@ -221,8 +277,9 @@ void Board::onUdpDatagram(const CharBuff* datagram)
  * @param port Connection port
  */
 EthInterfaceManager::EthInterfaceManager(const std::string& localAddress, int port, std::chrono::milliseconds timeout_) :
-  localAddress { localAddress }, numConfiguredBoards(0), sockId(0), port(port),
-  workerThread{}, workerStarted(false),continuing{true},timeoutHandler{}, timeout{timeout_}
+  localAddress { localAddress }, table(std::make_shared<const DispatchTable>()), sockId(INVALID_SOCKET), port(port),
+  workerThread{}, workerStarted(false), dispatchEpoch(0), epollId(INVALID_SOCKET), timerId(INVALID_SOCKET),
+  stopEventId(INVALID_SOCKET), continuing{true},timeoutHandler(std::make_shared<const timeoutHandler_t>()), timeout{timeout_}
 {
 }
 
@@ -235,7 +292,33 @@ EthInterfaceManager::~EthInterfaceManager()
   this->stopRecvThread();
 
   // close local "broadcast socket"
-  close(this->sockId);
+  if (this->sockId != INVALID_SOCKET)
+    close(this->sockId);
+}
+
+/**
+ * @brief Gives the manager bound to a local address and port, creating it if needed.
+ *        The manager, its socket and its receive thread are shared by all the owners
+ *        of the returned pointer and released with the last of them
+ * @param localAddress Address of the local interface
+ * @param port Local port of the broadcast socket
+ * @param timeout_ Timeout of the boards, used only if the manager is created
+ */
+std::shared_ptr<EthInterfaceManager> EthInterfaceManager::acquire(const std::string& localAddress, int port,
+                                                                  std::chrono::milliseconds timeout_)
+{
+  static std::mutex registryMutex;
+  static std::unordered_map<std::string, std::weak_ptr<EthInterfaceManager>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  std::weak_ptr<EthInterfaceManager>& entry = registry[localAddress + ":" + std::to_string(port)];
+  std::shared_ptr<EthInterfaceManager> manager = entry.lock();
+  if (!manager)
+  {
+    manager = std::make_shared<EthInterfaceManager>(localAddress, port, timeout_);
+    entry = manager;
+  }
+  return manager;
 }
 
 /**
@@ -243,7 +326,43 @@ EthInterfaceManager::~EthInterfaceManager()
  */
 void EthInterfaceManager::startRecvThread()
 {
+  std::lock_guard<std::mutex> lock(this->tableMutex);
+  if (this->workerStarted)
+    return;
+
   std::cerr << "Start Recv Thread"<<std::endl;
+
+  // The worker waits on the socket, on a periodic timer checking the board
+  // timeouts and on an event signalled by stopRecvThread
+  this->epollId = epoll_create1(EPOLL_CLOEXEC);
+  this->timerId = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  this->stopEventId = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (this->epollId == INVALID_SOCKET || this->timerId == INVALID_SOCKET || this->stopEventId == INVALID_SOCKET)
+  {
+    std::cerr << "Recv Thread initialization failed! Error code:  "<< errno <<  std::endl;
+    return;
+  }
+
+  struct itimerspec period;
+  period.it_interval.tv_sec = timeout.count() / 1000;
+  period.it_interval.tv_nsec = (timeout.count() % 1000) * 1000000;
+  period.it_value = period.it_interval;
+  timerfd_settime(this->timerId, 0, &period, nullptr);
+
+  for (int fd : {this->sockId, this->timerId, this->stopEventId})
+  {
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(this->epollId, EPOLL_CTL_ADD, fd, &event);
+  }
+
+  auto now = std::chrono::high_resolution_clock::now();
+  for (auto& board: this->table->boards)
+    if (board)
+      board->setLastDatagramTime(now);
+
+  this->continuing = true;
   this->workerThread = std::thread {&EthInterfaceManager::worker, this};
   this->workerStarted = true;
 }
@@ -256,36 +375,142 @@ void EthInterfaceManager::stopRecvThread()
   if (workerStarted)
   {
     this->continuing = false;
+    uint64_t stop = 1;
+    if (write(this->stopEventId, &stop, sizeof(stop)) != sizeof(stop))
+      std::cerr << "Recv Thread stop failed! Error code:  "<< errno <<  std::endl;
   }
   if (this->workerThread.joinable())
     this->workerThread.join();
+  this->workerStarted = false;
+
+  for (int* fd : {&this->epollId, &this->timerId, &this->stopEventId})
+  {
+    if (*fd != INVALID_SOCKET)
+    {
+      close(*fd);
+      *fd = INVALID_SOCKET;
+    }
+  }
 }
 
 /**
   * \brief This function add one board to array of Board class.
-  *  Only if the number of boards are not over 4 boards
   * @param address_ Ip address of board
   * @param tcpService_ Boolean which contains status of TCP connection(true connected)
   * @param tcpPort_ TCP port connection
   * @param udpService_ Boolean which contains status of UDP connection(true connected)
   * @param udpPort_ UDP port connection
-  * \return number of boardsAdded or -1 if full, it can be used as an ID
+  * \return number of boardsAdded, it can be used as an ID
  */
 board_id_t EthInterfaceManager::addBoard(string address_, bool tcpService_, int tcpPort_,
                            bool udpService_, int udpPort_)
 {
-  if (this->numConfiguredBoards >= MAX_NUM_BOARDS)
+  std::lock_guard<std::mutex> lock(this->tableMutex);
+  std::shared_ptr<DispatchTable> updated = std::make_shared<DispatchTable>(*this->table);
+
+  board_id_t boardId = updated->boards.size();
+  updated->boards.emplace_back(std::make_shared<Board>(address_, tcpService_, tcpPort_, udpService_, udpPort_));
+  updated->boards.back()->setLastDatagramTime(std::chrono::high_resolution_clock::now());
+
+  // Datagrams are dispatched by sender address and port; boards sharing an address
+  // with another one are told apart by their port only
+  uint32_t ip = inet_addr(address_.c_str());
+  updated->boardsBySender.emplace(senderKey(ip, udpPort_), boardId);
+  updated->boardsBySender.emplace(senderKey(ip, 0), boardId);
+
+  std::atomic_store(&this->table, std::shared_ptr<const DispatchTable>(std::move(updated)));
+  return boardId;
+}
+
+/**
+  * \brief Removes a board: when the function returns, its handlers are no more called
+  *        and can be destroyed. The ids of the other boards are unchanged
+  * @param boardId Identifier of the board
+ */
+void EthInterfaceManager::removeBoard(const board_id_t boardId)
+{
   {
-    return -1;
+    std::lock_guard<std::mutex> lock(this->tableMutex);
+    if (boardId < 0 || boardId >= (board_id_t)this->table->boards.size())
+      return;
+
+    std::shared_ptr<DispatchTable> updated = std::make_shared<DispatchTable>(*this->table);
+    updated->boards[boardId].reset();
+    for (auto entry = updated->boardsBySender.begin(); entry != updated->boardsBySender.end(); )
+    {
+      if (entry->second == boardId)
+        entry = updated->boardsBySender.erase(entry);
+      else
+        ++entry;
+    }
+    std::atomic_store(&this->table, std::shared_ptr<const DispatchTable>(std::move(updated)));
   }
 
-  this->boards[this->numConfiguredBoards] = std::unique_ptr<Board> { new Board(
-        address_, tcpService_, tcpPort_, udpService_, udpPort_) };
+  // The dispatch in progress may use the old table
+  this->waitDispatch();
+}
 
-  this->boardNumIp[this->numConfiguredBoards] = inet_addr(address_.c_str());
+/*!
+ * \brief Waits for the end of the dispatch in progress, if any. Called from
+ *        the receive thread (i.e. from a handler) it returns immediately
+ */
+void EthInterfaceManager::waitDispatch() const
+{
+  if (std::this_thread::get_id() == this->workerThread.get_id())
+    return;
+  uint64_t epoch = this->dispatchEpoch.load();
+  while ((epoch & 1) && this->dispatchEpoch.load() == epoch)
+    std::this_thread::yield();
+}
 
-  return (this->numConfiguredBoards++);
+/**
+ * @brief Board with the specified id, null if unknown or removed
+ */
+std::shared_ptr<Board> EthInterfaceManager::getBoard(const board_id_t boardId) const
+{
+  std::shared_ptr<const DispatchTable> current = std::atomic_load(&this->table);
+  if (boardId < 0 || boardId >= (board_id_t)current->boards.size())
+    return nullptr;
+  return current->boards[boardId];
+}
 
+/**
+ * @brief This function send message over TCP protocol by specific Board
+ * @param boardId Identifier of specific board
+ * @param packetToBeSent Buffer which contains the message to be sent
+ * @return  Number of byte sent otherwise -1, this means error on trasmission data
+ */
+int EthInterfaceManager::sendTcpFromBoard(const board_id_t boardId,
+                                          const CharBuff* packetToBeSent) const
+{
+  std::shared_ptr<Board> board = this->getBoard(boardId);
+  return board ? board->sendTcp(packetToBeSent) : -1;
+}
+
+/**
+ * @brief This function receive message over TCP protocol by specific Board
+ * @param boardId Identifier of specific board
+ * @param packetToBeReceived  Buffer which contains the received message
+ * @return Number of byte received otherwise -1, this means error .
+ */
+int EthInterfaceManager::recvTcpFromBoard(const board_id_t boardId,
+                                          CharBuff* packetToBeReceived) const
+{
+  std::shared_ptr<Board> board = this->getBoard(boardId);
+  return board ? board->recvTcp(packetToBeReceived) : -1;
+}
+
+/**
+ * @brief This function send message over UDP protocol by specific Board
+ * @param boardId Identifier of specific board
+ * @param packetToBeSent Buffer which contains the message to be sent
+ * @return  Number of byte sent otherwise -1, this means error on trasmission data
+ */
+int EthInterfaceManager::sendUdpFromBoard(const uint16_t boardId,
+                                          const CharBuff* packetToBeSent) const
+{
+  std::shared_ptr<Board> board = this->getBoard(boardId);
+  return board ? board->sendUdp(packetToBeSent) : -1;
 }
 
 /*!
@@ -319,6 +544,13 @@ RC EthInterfaceManager::bind()
     return RC::UNKNOWN_ERR;
   }
 
+  // Timestamp the datagrams when they reach the kernel, not when they are read
+  if (setsockopt(this->sockId, SOL_SOCKET, SO_TIMESTAMPNS, (char*) &iOptVal,
+                 iOptLen) == SOCKET_ERROR)
+  {
+    std::cerr << "SO_TIMESTAMPNS not available, using read times. Error code:   "<< errno <<  std::endl;
+  }
+
   if (::bind(this->sockId, (struct sockaddr *) &(localAddress),
              sizeof(localAddress)) == SOCKET_ERROR) //Error at bind()
   {
@@ -334,20 +566,24 @@ RC EthInterfaceManager::bind()
 }
 
 /*!
- * \brief Connect to all the configured boards
+ * \brief Connect to all the configured boards not connected yet,
+ *        binding the broadcast socket the first time
  */
 RC EthInterfaceManager::connectAll()
 {
   rehab::RC rc = RC::OK;
 
-  if (this->bind() != RC::OK)
+  std::lock_guard<std::mutex> lock(this->tableMutex);
+  if (this->sockId == INVALID_SOCKET && this->bind() != RC::OK)
   {
     return RC::UNKNOWN_ERR;
   }
 
-  for (int i = 0; i < this->numConfiguredBoards; i++)
+  for (auto& board : this->table->boards)
   {
-    rc = this->boards[i]->connect(this->sockId);
+    if (!board || board->isConnected())
+      continue;
+    rc = board->connect(this->sockId);
     if (rc != RC::OK)
     {
       std::cerr << "connect() failed! Error code: "<< errno <<  std::endl;
@@ -366,83 +602,175 @@ RC EthInterfaceManager::connectAll()
 void EthInterfaceManager::installUdpDatagramHandler(const uint16_t boardId,
                                                     udpMessageHandler_t &&msgHandle)
 {
-  if (boardId < this->numConfiguredBoards)
+  std::shared_ptr<Board> board = this->getBoard(boardId);
+  if (board)
   {
-    this->boards[boardId]->installUdpDatagramHandler(std::move(msgHandle));
+    board->installUdpDatagramHandler(std::move(msgHandle));
   }
 }
 
+/*!
+ * \brief Install the handler called, every timeout, with the id of each board
+ *        from which nothing has been received during the last timeout
+ * \param msgHandle     Pointer to function that takes care of the timeout
+ */
 void EthInterfaceManager::installTimeoutHandler(timeoutHandler_t &&msgHandle)
 {
   auto now = std::chrono::high_resolution_clock::now();
-  for ( auto& last: this->lastTimePoint)
-    last = now;
-  this->timeoutHandler = std::move(msgHandle);
+  for (auto& board: std::atomic_load(&this->table)->boards)
+    if (board)
+      board->setLastDatagramTime(now);
+  std::atomic_store(&this->timeoutHandler, std::make_shared<const timeoutHandler_t>(std::move(msgHandle)));
 }
 
 /*!
- * \brief This function receive message over UDP protocol
- * \param packetToReceive  Buffer which contains the received message
- * \param timeout Timeout for receiving message
- * \return Number of Bytes received; -1 on timeout
+ * \brief Install a handler called, every timeout, if nothing has been
+ *        received from the board during the last timeout
+ * \param boardId Identifier of the board
+ * \param timeoutHandle Function that takes care of the timeout
  */
-int EthInterfaceManager::recvUdp(CharBuff* packetToReceive)
+void EthInterfaceManager::installTimeoutHandler(const board_id_t boardId, timeoutHandler_t&& timeoutHandle)
 {
-  struct sockaddr_in SenderAddr;
-  socklen_t SenderAddrSize = sizeof(SenderAddr);
-
-  fd_set readset;
-
-  // Initialize the set
-  FD_ZERO(&readset);
-  FD_SET(this->sockId, &readset);
-
-
-  struct timeval tv;
-  // Initialize time out struct
-  tv.tv_sec = 0;
-  tv.tv_usec = timeout.count() * 1000;
-  // select()
-  auto result = select(this->sockId + 1, &readset, NULL, NULL, &tv);
-  if (result <= 0)
+  std::shared_ptr<Board> board = this->getBoard(boardId);
+  if (board)
   {
-    if (timeoutHandler)
-      timeoutHandler(99);
-    return -1;
+    board->setLastDatagramTime(std::chrono::high_resolution_clock::now());
+    board->installTimeoutHandler(std::move(timeoutHandle));
   }
+}
 
+/*!
+ * \brief Removes the datagram and timeout handlers of a board: when the
+ *        function returns, they are no more called and can be destroyed
+ * \param boardId Identifier of the board
+ */
+void EthInterfaceManager::removeHandlers(const board_id_t boardId)
+{
+  std::shared_ptr<Board> board = this->getBoard(boardId);
+  if (board)
+  {
+    board->removeHandlers();
+    this->waitDispatch();
+  }
+}
 
-  // TODO Better way to handle errors?
-  int BytesReceived = recvfrom(this->sockId, (char*) packetToReceive->content,
-                               sizeof(packetToReceive->content), 0, (struct sockaddr *) &SenderAddr,
-                               &SenderAddrSize);
-  packetToReceive->size = BytesReceived;
+/*!
+ * \brief Finds the board which sent a datagram
+ * \param sender Address of the sender
+ * \return Identifier of the board, -1 if the sender is unknown
+ */
+board_id_t EthInterfaceManager::findBoard(const DispatchTable& dispatch, const struct sockaddr_in& sender)
+{
+  auto board = dispatch.boardsBySender.find(senderKey(sender.sin_addr.s_addr, ntohs(sender.sin_port)));
+  if (board == dispatch.boardsBySender.end())
+    board = dispatch.boardsBySender.find(senderKey(sender.sin_addr.s_addr, 0));
+  return (board != dispatch.boardsBySender.end()) ? board->second : -1;
+}
 
-  for (int i = 0; i < this->numConfiguredBoards; i++)
+/*!
+ * \brief Calls the timeout handler for every board silent for more than timeout
+ */
+void EthInterfaceManager::checkTimeouts()
+{
+  auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+  // dispatched as the datagrams, so that removeBoard waits for the handlers in progress
+  this->dispatchEpoch.fetch_add(1);
+  std::shared_ptr<const DispatchTable> current = std::atomic_load(&this->table);
+  std::shared_ptr<const timeoutHandler_t> handler = std::atomic_load(&this->timeoutHandler);
+  for (board_id_t i = 0; i < (board_id_t)current->boards.size(); i++)
   {
-    if (SenderAddr.sin_addr.s_addr == boardNumIp[i])
+    if (current->boards[i] &&
+        std::chrono::duration_cast< std::chrono::milliseconds >(now-current->boards[i]->getLastDatagramTime()) > timeout)
     {
-      this->lastTimePoint[i] =  std::chrono::high_resolution_clock::now();
+      current->boards[i]->onTimeout(i);
+      if (*handler)
+        (*handler)(i);
+    }
+  }
+  this->dispatchEpoch.fetch_add(1);
+}
 
-      this->boards[i]->onUdpDatagram(packetToReceive);
+/**
+ * @brief Buffers of a batch of datagrams received by a single system call
+ */
+struct EthInterfaceManager::ReceiveBuffers
+{
+  ReceiveBuffers()
+  {
+    for (unsigned i = 0; i < RECV_BATCH_SIZE; i++)
+    {
+      vectors[i].iov_base = datagrams[i].content;
+      vectors[i].iov_len = sizeof(datagrams[i].content);
+      headers[i] = mmsghdr();
+      headers[i].msg_hdr.msg_iov = &vectors[i];
+      headers[i].msg_hdr.msg_iovlen = 1;
+      headers[i].msg_hdr.msg_name = &senders[i];
+      headers[i].msg_hdr.msg_control = controls[i].data();
     }
   }
 
-  auto now = std::chrono::high_resolution_clock::now();
-  for (int i = 0; i < this->numConfiguredBoards; i++)
+  /**
+   * @brief Kernel receive time of a datagram
+   * @param i Index of the datagram in the batch
+   * @param readTime Time used if the datagram has no timestamp
+   */
+  receiveTime_t receiveTime(unsigned i, receiveTime_t readTime)
   {
-    auto duration = std::chrono::duration_cast< std::chrono::milliseconds >(now-this->lastTimePoint[i]);
-    if (duration > timeout  )
+    for (struct cmsghdr* control = CMSG_FIRSTHDR(&headers[i].msg_hdr); control != nullptr;
+         control = CMSG_NXTHDR(&headers[i].msg_hdr, control))
     {
+      if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS)
       {
-        if (timeoutHandler)
-          timeoutHandler(i);
+        struct timespec stamp;
+        memcpy(&stamp, CMSG_DATA(control), sizeof(stamp));
+        return receiveTime_t(std::chrono::duration_cast<receiveTime_t::duration>(
+                               std::chrono::seconds(stamp.tv_sec) + std::chrono::nanoseconds(stamp.tv_nsec)));
       }
+    }
+    return readTime;
+  }
+
+  std::array<CharBuff, RECV_BATCH_SIZE> datagrams;
+  std::array<struct iovec, RECV_BATCH_SIZE> vectors;
+  std::array<struct mmsghdr, RECV_BATCH_SIZE> headers;
+  std::array<struct sockaddr_in, RECV_BATCH_SIZE> senders;
+  std::array<std::array<uint8_t, CMSG_SPACE(sizeof(struct timespec))>, RECV_BATCH_SIZE> controls;
+};
+
+/*!
+ * \brief Receives the pending datagrams and gives them to the boards which sent them
+ * \param buffers Buffers of the datagrams
+ * \return Number of datagrams received; -1 on error
+ */
+int EthInterfaceManager::receiveBatch(ReceiveBuffers& buffers)
+{
+  for (unsigned i = 0; i < RECV_BATCH_SIZE; i++)
+  {
+    buffers.headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    buffers.headers[i].msg_hdr.msg_controllen = buffers.controls[i].size();
+  }
 
+  int received = recvmmsg(this->sockId, buffers.headers.data(), RECV_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+  if (received <= 0)
+    return -1;
+
+  auto now = std::chrono::high_resolution_clock::now();
+  auto readTime = std::chrono::system_clock::now();
+  this->dispatchEpoch.fetch_add(1);
+  std::shared_ptr<const DispatchTable> current = std::atomic_load(&this->table);
+  for (int i = 0; i < received; i++)
+  {
+    buffers.datagrams[i].size = buffers.headers[i].msg_len;
+    board_id_t board = findBoard(*current, buffers.senders[i]);
+    if (board >= 0)
+    {
+      current->boards[board]->setLastDatagramTime(now);
+      current->boards[board]->onUdpDatagram(&buffers.datagrams[i], buffers.receiveTime(i, readTime));
     }
   }
+  this->dispatchEpoch.fetch_add(1);
 
-  return BytesReceived;
+  return received;
 }
 
 /**
@@ -450,14 +778,33 @@ int EthInterfaceManager::recvUdp(CharBuff* packetToReceive)
  */
 void EthInterfaceManager::worker()
 {
+  std::unique_ptr<ReceiveBuffers> buffers{new ReceiveBuffers};
+  std::array<struct epoll_event, 3> events;
 
   while (continuing)
   {
-    auto rc = this->recvUdp(&cbUdpRec);
-    if (rc == -1) {
-      // TIMEOUT ERROR
+    int ready = epoll_wait(this->epollId, events.data(), events.size(), -1);
+    if (ready < 0 && errno != EINTR)
+    {
+      std::cerr << "epoll_wait() failed! Error code:  "<< errno <<  std::endl;
+      break;
     }
 
+    for (int i = 0; i < ready; i++)
+    {
+      if (events[i].data.fd == this->sockId)
+      {
+        // one batch per wake up: the socket is level triggered, so the datagrams
+        // left are read at the next iteration, after the timer has been served
+        this->receiveBatch(*buffers);
+      }
+      else if (events[i].data.fd == this->timerId)
+      {
+        uint64_t expirations;
+        if (read(this->timerId, &expirations, sizeof(expirations)) > 0)
+          this->checkTimeouts();
+      }
+    }
   }
 }
 
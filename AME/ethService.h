@@ -21,6 +21,9 @@
 #include <thread>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <chrono>
 #include <cstdint>
 #include <type_traits>
 
@@ -39,7 +42,8 @@ namespace Ethservice {
 
 // Max Size of ethernet Packet
 constexpr size_t PACKET_MAX_SIZE{256};
-constexpr board_id_t MAX_NUM_BOARDS {4};
+// Max number of datagrams read by a single system call
+constexpr unsigned RECV_BATCH_SIZE{32};
 ///Error for invalid socket selection
 constexpr int INVALID_SOCKET {-1};
 ///Generic socket error
@@ -47,7 +51,9 @@ constexpr int SOCKET_ERROR{-1};
 
 using std::string;
 using CharBuff=rehab::CharBuff_t<PACKET_MAX_SIZE>;
-using udpMessageHandler_t = std::function<void(const CharBuff*)>;
+/// Time at which a datagram has been received, taken by the kernel when available
+using receiveTime_t = std::chrono::system_clock::time_point;
+using udpMessageHandler_t = std::function<void(const CharBuff*, receiveTime_t)>;
 using timeoutHandler_t = std::function<void(board_id_t)>;
 
 static constexpr const size_t MAC_ADDRESS_SIZE   = 8;
@@ -172,12 +178,19 @@ public:
       int udpPort_) :
       address(address_), tcpService(tcpService_), tcpPort(tcpPort_), udpService(
           udpService_), udpPort(udpPort_), tcpConn(address_, tcpPort_), udpConn(
-          address_, udpPort_)
+          address_, udpPort_), connected(false), msgh(std::make_shared<const HandlerList>()),
+          timeoutHandlers(std::make_shared<const TimeoutHandlerList>()), lastDatagramTime(0)
   {
   }
 
   rehab::RC connect(int udpSockId);
 
+  /**
+   * @brief Check if the board has already been connected
+   * @return true if connect() succeeded
+   */
+  bool isConnected() const  {    return this->connected;  }
+
   /**
  * \brief This function send message over TCP protocol of specific board
  *        only if TCP service is active
@@ -232,9 +245,31 @@ public:
 
   void installUdpDatagramHandler(udpMessageHandler_t&& msgHandle);
 
-  void onUdpDatagram(const CharBuff* datagram);
+  void onUdpDatagram(const CharBuff* datagram, receiveTime_t receiveTime);
+
+  void installTimeoutHandler(timeoutHandler_t&& timeoutHandle);
+  void removeHandlers();
+
+  void onTimeout(board_id_t boardId);
+
+  /**
+   * @brief Time of the last datagram received from the board
+   * @return Time since the epoch of the high resolution clock, 0 if none
+   */
+  std::chrono::high_resolution_clock::duration getLastDatagramTime() const
+  {
+    return std::chrono::high_resolution_clock::duration(lastDatagramTime.load(std::memory_order_relaxed));
+  }
+
+  void setLastDatagramTime(std::chrono::high_resolution_clock::time_point time)
+  {
+    lastDatagramTime.store(time.time_since_epoch().count(), std::memory_order_relaxed);
+  }
 
 private:
+  using HandlerList = std::vector<udpMessageHandler_t>;
+  using TimeoutHandlerList = std::vector<timeoutHandler_t>;
+
   const string address;
   const bool tcpService;
   const int tcpPort;
@@ -242,7 +277,12 @@ private:
   const int udpPort;
   TCPConnector tcpConn;
   UDPConnector udpConn;
-  std::vector<udpMessageHandler_t> msgh;
+  bool connected;
+  /// Handlers, replaced (never modified) when one is installed, as the receive thread may be using them
+  std::shared_ptr<const HandlerList> msgh;
+  /// Timeout handlers, replaced as the handlers of the datagrams
+  std::shared_ptr<const TimeoutHandlerList> timeoutHandlers;
+  std::atomic<std::chrono::high_resolution_clock::rep> lastDatagramTime;
 };
 
 
@@ -259,6 +299,9 @@ public:
 
   EthInterfaceManager(const std::string& localAddress, int port, std::chrono::milliseconds timeout_=fiftyMillis);
 
+  static std::shared_ptr<EthInterfaceManager> acquire(const std::string& localAddress, int port,
+      std::chrono::milliseconds timeout_=fiftyMillis);
+
   /**
      * @brief The destructor is not virtual because the class is Final
      *        and is meant not to be overriden
@@ -267,6 +310,8 @@ public:
 
   board_id_t addBoard(string address_, bool tcpService_, int tcpPort_,
       bool udpService_, int udpPort_);
+  void removeBoard(const board_id_t boardId);
+  std::shared_ptr<Board> getBoard(const board_id_t boardId) const;
 
   rehab::RC connectAll();
 
@@ -274,73 +319,64 @@ public:
   void startRecvThread();
   void stopRecvThread();
 
-  /**
-   * @brief This function send message over TCP protocol by specific Board
-   * @param boardId Identifier of specific board
-   * @param packetToBeSent Buffer which contains the message to be sent
-   * @return  Number of byte sent otherwise -1, this means error on trasmission data
-   */
   int sendTcpFromBoard(const board_id_t boardId,
-      const CharBuff* packetToBeSent) const
-  {
-    return (
-        (boardId < this->numConfiguredBoards) ?
-            this->boards[boardId]->sendTcp(packetToBeSent) : -1);
-  }
-
-  /**
-   * @brief This function receive message over TCP protocol by specific Board
-   * @param boardId Identifier of specific board
-   * @param packetToBeReceived  Buffer which contains the received message
-   * @return Number of byte received otherwise -1, this means error .
-   */
+      const CharBuff* packetToBeSent) const;
   int recvTcpFromBoard(const board_id_t boardId,
-      CharBuff* packetToBeReceived) const
-  {
-    return (
-        (boardId < this->numConfiguredBoards) ?
-            this->boards[boardId]->recvTcp(packetToBeReceived) : -1);
-  }
-
-  /**
-   * @brief This function send message over UDP protocol by specific Board
-   * @param boardId Identifier of specific board
-   * @param packetToBeSent Buffer which contains the message to be sent
-   * @return  Number of byte sent otherwise -1, this means error on trasmission data
-   */
+      CharBuff* packetToBeReceived) const;
   int sendUdpFromBoard(const uint16_t boardId,
-      const CharBuff* packetToBeSent) const
-  {
-    return (
-        (boardId < this->numConfiguredBoards) ?
-            this->boards[boardId]->sendUdp(packetToBeSent) : -1);
-  }
-
-  int recvUdp(CharBuff* packetToBeReceived) ;
+      const CharBuff* packetToBeSent) const;
 
   void installUdpDatagramHandler(const uint16_t boardId,
       udpMessageHandler_t&& msgHandle);
 
   void installTimeoutHandler(timeoutHandler_t&& msgHandle);
+  void installTimeoutHandler(const board_id_t boardId, timeoutHandler_t&& timeoutHandle);
+  void removeHandlers(const board_id_t boardId);
+
+  /**
+   * @brief Period of the timeout checks, and time without datagrams after which a board is timed out
+   */
+  std::chrono::milliseconds getTimeout() const  {    return timeout;  }
 
 private:
+  /**
+   * @brief Boards and dispatch map, replaced (never modified) when a board is
+   *        added or removed, so that the receive thread reads them without locking
+   */
+  struct DispatchTable
+  {
+    /// Boards indexed by id, null once removed
+    std::vector<std::shared_ptr<Board>> boards;
+    /// Board of each sender, keyed by address and port (port 0 matches any port)
+    std::unordered_map<uint64_t, board_id_t> boardsBySender;
+  };
+
   std::string localAddress;
-  std::array<std::unique_ptr<Board>, MAX_NUM_BOARDS> boards;
-  std::array< std::chrono::time_point<std::chrono::high_resolution_clock>, MAX_NUM_BOARDS> lastTimePoint;
-  uint32_t boardNumIp[MAX_NUM_BOARDS];
-  board_id_t numConfiguredBoards;
+  std::shared_ptr<const DispatchTable> table;
+  /// Serializes the writers of the table
+  std::mutex tableMutex;
   int sockId;
   int port;
 
   rehab::RC bind();
+  static board_id_t findBoard(const DispatchTable& dispatch, const struct sockaddr_in& sender);
+  void checkTimeouts();
+  void waitDispatch() const;
 
   // Receiver Thread Management
+  struct ReceiveBuffers;
   void worker();
+  int receiveBatch(ReceiveBuffers& buffers);
   std::thread workerThread;
   bool workerStarted;
-  CharBuff cbUdpRec;
+  /// Odd while the receive thread is dispatching datagrams
+  std::atomic<uint64_t> dispatchEpoch;
+  int epollId;
+  int timerId;
+  int stopEventId;
   std::atomic<bool> continuing;
-  timeoutHandler_t timeoutHandler;
+  /// Handler of the timeouts of every board, replaced (never modified) as the dispatch table
+  std::shared_ptr<const timeoutHandler_t> timeoutHandler;
   std::chrono::milliseconds timeout;
 };
 
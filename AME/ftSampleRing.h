@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @version 1.0
+ *
+ * @copyright (c) IIT Fondazione Istituto Italiano
+ *            di Tecnologia. All rights reserved
+ *
+ * @brief Ring of the timestamped samples of a sensor
+ */
+
+#ifndef FTSAMPLERING_H_
+#define FTSAMPLERING_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rehab
+{
+
+/**
+ * @brief Fixed capacity ring of the last samples received from a sensor.
+ *
+ *        Samples are numbered with a sequence starting from 1, so that a reader can keep
+ *        the sequence of the last sample it consumed and read the newer ones in a batch.
+ *        There is one writer, the receiving thread, which never waits for the readers:
+ *        every slot is protected by a seqlock (the sequence of its sample, 0 while it is written)
+ *        and a reader retries or skips a sample overwritten while it copies it.
+ * @tparam N Number of values of a sample
+ */
+template <size_t N>
+class FtSampleRing final
+{
+public:
+  using Values = std::array< float, N >;
+
+  /// A sample with the time at which it has been received
+  struct TimedSample
+  {
+    uint64_t sequence;
+    double timestamp;
+    Values values;
+  };
+
+  /**
+   * @brief Allocates the ring
+   * @param capacity Number of samples kept, at least 1
+   */
+  explicit FtSampleRing(size_t capacity) :
+    slots(capacity > 0 ? capacity : 1), slotSequences(new std::atomic<uint64_t>[slots.size()]), last(0)
+  {
+    for (size_t i = 0; i < slots.size(); ++i)
+      slotSequences[i].store(0, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const  {    return slots.size();  }
+
+  /**
+   * @brief Sequence of the last sample pushed, 0 if none
+   */
+  uint64_t lastSequence() const  {    return last.load(std::memory_order_acquire);  }
+
+  /**
+   * @brief Appends a sample, overwriting the oldest one. Only one thread may push
+   * @param values Values of the sample
+   * @param timestamp Time of the sample
+   */
+  void push(const Values& values, double timestamp)
+  {
+    uint64_t sequence = last.load(std::memory_order_relaxed) + 1;
+    size_t slot = (sequence - 1) % slots.size();
+
+    slotSequences[slot].store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slots[slot].values = values;
+    slots[slot].timestamp = timestamp;
+    slotSequences[slot].store(sequence, std::memory_order_release);
+
+    last.store(sequence, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copies the sample with the specified sequence
+   * @return false if it has not been pushed yet or has been overwritten
+   */
+  bool read(uint64_t sequence, TimedSample& sample) const
+  {
+    if (sequence == 0)
+      return false;
+    size_t slot = (sequence - 1) % slots.size();
+    if (slotSequences[slot].load(std::memory_order_acquire) != sequence)
+      return false;
+    sample.values = slots[slot].values;
+    sample.timestamp = slots[slot].timestamp;
+    sample.sequence = sequence;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slotSequences[slot].load(std::memory_order_relaxed) == sequence;
+  }
+
+  /**
+   * @brief Copies the newest sample
+   * @return false if the ring is empty
+   */
+  bool readLatest(TimedSample& sample) const
+  {
+    while (true)
+    {
+      uint64_t sequence = lastSequence();
+      if (sequence == 0)
+        return false;
+      if (read(sequence, sample))
+        return true;
+      // overwritten while copying: take the new latest
+    }
+  }
+
+  /**
+   * @brief Copies the samples pushed after the one with sequence cursor, oldest first
+   * @param cursor Sequence of the last sample already read, updated to the last one copied
+   * @param samples Samples appended
+   * @return Number of samples lost, overwritten before being read
+   */
+  uint64_t readSince(uint64_t& cursor, std::vector<TimedSample>& samples) const
+  {
+    uint64_t newest = lastSequence();
+    uint64_t oldest = newest >= slots.size() ? newest - slots.size() + 1 : 1;
+    uint64_t lost = 0;
+    if (cursor + 1 < oldest)
+    {
+      lost = oldest - cursor - 1;
+      cursor = oldest - 1;
+    }
+
+    TimedSample sample;
+    for (uint64_t sequence = cursor + 1; sequence <= newest; ++sequence)
+    {
+      if (read(sequence, sample))
+        samples.push_back(sample);
+      else
+        ++lost;
+      cursor = sequence;
+    }
+    return lost;
+  }
+
+private:
+  struct Slot
+  {
+    double timestamp;
+    Values values;
+  };
+
+  std::vector<Slot> slots;
+  std::unique_ptr<std::atomic<uint64_t>[]> slotSequences; ///< sequence of the sample of each slot, 0 while writing
+  std::atomic<uint64_t> last;
+};
+
+}
+
+#endif /* FTSAMPLERING_H_ */
@@ -12,6 +12,10 @@
 #include "ethService.h"
 #include "Multitorque.h"
 #include "MultitorqueEncoder.h"
+#include "MultitorqueCodec.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace rehab
 {
@@ -20,53 +24,138 @@ using namespace Multitorque;
 using namespace Ethservice;
 using rehab::RC;
 
+constexpr const std::chrono::milliseconds FtSensorNew::COMMAND_TIMEOUT;
+constexpr const std::chrono::milliseconds FtSensorNew::DEFAULT_MAX_SAMPLE_AGE;
+constexpr const uint64_t FtSensorNew::RATE_WINDOW;
+
 
 /**
    * @brief This function is called by the receiving thread to extract meaningful data
    * @param packetToReceive Buffer received from sensor
+   * @param receiveTime Time at which the buffer has been received
    */
-void FtSensorNew::analyzePacketSensor(const CharBuff* packetToReceive)
+void FtSensorNew::analyzePacketSensor(const CharBuff* packetToReceive, receiveTime_t receiveTime)
 {
-  using namespace Multitorque;
-  static BCastSensorData bCastSensorData;
-  decode(bCastSensorData, (packetToReceive->content),  sizeof(CharBuff));
-
-  std::lock_guard< std::mutex > lock(sensor_mutex);
+  Codec::MessageView<BCastSensorData> view(packetToReceive->content, packetToReceive->size);
+  if (!view.isValid())
   {
-    Fx = bCastSensorData.getFx();
-    Fy = bCastSensorData.getFy();
-    Fz = bCastSensorData.getFz();
-    Tx = bCastSensorData.getTx();
-    Ty = bCastSensorData.getTy();
-    Tz = bCastSensorData.getTz();
-    raw[0] = bCastSensorData.getRaw0();
-    raw[1] = bCastSensorData.getRaw1();
-    raw[2] = bCastSensorData.getRaw2();
-    raw[3] = bCastSensorData.getRaw3();
-    raw[4] = bCastSensorData.getRaw4();
-    raw[5] = bCastSensorData.getRaw5();
+    if (view.getStatus() == Codec::VIEW_WRONG_ID)
+      wrongIdDatagrams.fetch_add(1, std::memory_order_relaxed);
+    else
+      malformedDatagrams.fetch_add(1, std::memory_order_relaxed);
+    return;
   }
+
+  SampleValues values;
+  view.copyFields(0, SAMPLE_VALUES, values.data());
+  samples.push(values, std::chrono::duration<double>(receiveTime.time_since_epoch()).count());
+
+  receivedDatagrams.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+   * @brief Copies the last sample
+   * @param values Force, torque and raw values of the sample, zero if none has been received
+   */
+void FtSensorNew::readSample(SampleValues &values) const
+{
+  FtSampleRing< SAMPLE_VALUES >::TimedSample sample;
+  if (samples.readLatest(sample))
+    values = sample.values;
+  else
+    values.fill(0);
 }
 
 /**
- * @brief FtSensorNew::isConnectivityOk
- * @return
+ * @brief Counters of the datagrams received from the sensor
  */
-bool FtSensorNew::isConnectivityOk()
+FtSensorNew::DatagramStatistics FtSensorNew::getDatagramStatistics() const
 {
-  return true;
+  DatagramStatistics statistics;
+  statistics.received = receivedDatagrams.load(std::memory_order_relaxed);
+  statistics.malformed = malformedDatagrams.load(std::memory_order_relaxed);
+  statistics.wrongId = wrongIdDatagrams.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+/**
+ * @brief Seconds since the last sample has been received
+ * @return Age of the last sample, infinity if none has been received
+ */
+double FtSensorNew::lastSampleAge() const
+{
+  FtSampleRing< SAMPLE_VALUES >::TimedSample sample;
+  if (!samples.readLatest(sample))
+    return std::numeric_limits<double>::infinity();
+  double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+  return now - sample.timestamp;
+}
+
+/**
+ * @brief Checks that the sensor is streaming
+ * @return true if a sample has been received within the max sample age
+ */
+bool FtSensorNew::isConnectivityOk() const
+{
+  return lastSampleAge() * 1000 <= maxSampleAge.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the age after which the last sample is stale
+ * @param maxAge Max age of the last sample
+ */
+void FtSensorNew::setMaxSampleAge(std::chrono::milliseconds maxAge)
+{
+  maxSampleAge.store(maxAge.count(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Liveness of the sensor. Nothing is added to the receiving thread:
+ *        age and rate come from the samples kept, the missed deadlines from the timeouts
+ *        of the manager
+ */
+FtSensorNew::Liveness FtSensorNew::getLiveness() const
+{
+  Liveness liveness;
+  liveness.lastSampleAge = lastSampleAge();
+  liveness.alive = liveness.lastSampleAge * 1000 <= maxSampleAge.load(std::memory_order_relaxed);
+  liveness.missedDeadlines = missedDeadlines.load(std::memory_order_relaxed);
+  liveness.observedRate = 0;
+
+  // the first sample of the window may be overwritten while it is read: retry with the new latest
+  uint64_t window = std::min< uint64_t >(RATE_WINDOW, samples.capacity() - 1);
+  FtSampleRing< SAMPLE_VALUES >::TimedSample latest, first;
+  for (int attempt = 0; attempt < 3 && window > 0; ++attempt)
+  {
+    if (!samples.readLatest(latest) || latest.sequence < 2)
+      break;
+    if (samples.read(latest.sequence - std::min(window, latest.sequence - 1), first))
+    {
+      if (latest.timestamp > first.timestamp)
+        liveness.observedRate = (latest.sequence - first.sequence) / (latest.timestamp - first.timestamp);
+      break;
+    }
+  }
+  return liveness;
 }
 
 /**
  * @brief Create the interface to the control sensor device
  * @param bdm_ Pointer of Ethservice::EthInterfaceManager class
  * @param bdid_ Integer value which represents board identity
+ * @param historySize Number of samples kept for getFTHistory
  */
-FtSensorNew::FtSensorNew(Ethservice::EthInterfaceManager* bdm_, board_id_t bdid_):
-  bdm{bdm_}, bdid{bdid_}
+FtSensorNew::FtSensorNew(Ethservice::EthInterfaceManager* bdm_, board_id_t bdid_, size_t historySize):
+  bdm{bdm_}, bdid{bdid_}, commands{bdm_->getBoard(bdid_)}, samples{historySize}
 {
-  memset( &this->cb, 0x0, sizeof(Ethservice::CharBuff));
-  bdm->installUdpDatagramHandler(bdid, [this](const CharBuff* bf) {this->analyzePacketSensor(bf); });
+  bdm->installUdpDatagramHandler(bdid, [this](const CharBuff* bf, receiveTime_t receiveTime) {
+    this->analyzePacketSensor(bf, receiveTime);
+  });
+  // before the first sample the board is not streaming yet: nothing is missed
+  bdm->installTimeoutHandler(bdid, [this](board_id_t) {
+    if (samples.lastSequence() > 0)
+      missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+  });
 }
 
 /**
@@ -74,7 +163,10 @@ FtSensorNew::FtSensorNew(Ethservice::EthInterfaceManager* bdm_, board_id_t bdid_
    *        and is meant not to be overriden
    */
 FtSensorNew::~FtSensorNew()
-{  }
+{
+  // the handlers capture this: the receive thread must be done with them
+  bdm->removeHandlers(bdid);
+}
 
 /**
    * @brief Assign values Force and Torque to array Sensor Data
@@ -84,16 +176,65 @@ FtSensorNew::~FtSensorNew()
    */
 int32_t FtSensorNew::getFTData (FTSensorData &ftData)
 {
-  std::lock_guard < std::mutex > lock(sensor_mutex);
-  ftData[0] = Fx / 1000.0 ;
-  ftData[1] = Fy / 1000.0 ;
-  ftData[2] = Fz / 1000.0 ;
-  ftData[3] = Tx / 1000.0 ;
-  ftData[4] = Ty / 1000.0 ;
-  ftData[5] = Tz / 1000.0 ;
+  SampleValues values;
+  readSample(values);
+  for (size_t i = 0; i < FT_SENSOR_AXIS; ++i)
+    ftData[i] = values[i] / 1000.0 ;
+  return 0;
+}
+
+/**
+   * @brief Gets the last force and torque with the time they have been received
+   * @param ftData Force in N and torque in Nm
+   * @param timestamp Receive time of the sample, in seconds since the epoch
+   * @param sequence Number of the sample: it changes only when a new sample is received
+   * @return 0 means no errors, -1 if no sample has been received yet
+   */
+int32_t FtSensorNew::getFTData (FTSensorData &ftData, double &timestamp, uint64_t &sequence)
+{
+  FtSampleRing< SAMPLE_VALUES >::TimedSample sample;
+  if (!samples.readLatest(sample))
+    return -1;
+  for (size_t i = 0; i < FT_SENSOR_AXIS; ++i)
+    ftData[i] = sample.values[i] / 1000.0 ;
+  timestamp = sample.timestamp;
+  sequence = sample.sequence;
   return 0;
 }
 
+/**
+   * @brief Gets the last sample as broadcast by the board
+   * @param sample Force and torque in thousandths of N and Nm then raw channels,
+   *        with the receive time and number of the sample
+   * @return 0 means no errors, -1 if no sample has been received yet
+   */
+int32_t FtSensorNew::getLatestSample (TimedSample &sample)
+{
+  return samples.readLatest(sample) ? 0 : -1;
+}
+
+/**
+   * @brief Gets the samples received since the last call
+   * @param cursor Sequence of the last sample read, 0 at the first call; updated
+   * @param history Samples appended, oldest first
+   * @return Number of samples lost since the last call, as the history was too short
+   */
+uint64_t FtSensorNew::getFTHistory (uint64_t &cursor, std::vector<TimedFTData> &history)
+{
+  std::vector< FtSampleRing< SAMPLE_VALUES >::TimedSample > received;
+  auto lost = samples.readSince(cursor, received);
+  for (auto& sample : received)
+  {
+    TimedFTData data;
+    data.sequence = sample.sequence;
+    data.timestamp = sample.timestamp;
+    for (size_t i = 0; i < FT_SENSOR_AXIS; ++i)
+      data.ftData[i] = sample.values[i] / 1000.0 ;
+    history.push_back(data);
+  }
+  return lost;
+}
+
 /**
    * @brief Gets all 6 values for specified row of matrix
    * @param rawFTData FTSensorData array which contains all value of force in N
@@ -101,48 +242,105 @@ int32_t FtSensorNew::getFTData (FTSensorData &ftData)
    */
 int32_t FtSensorNew::getRawFTData (FTSensorData &rawFTData)
 {
-  std::lock_guard < std::mutex > lock(sensor_mutex);
-  memcpy(rawFTData.data(), raw.data(), sizeof(raw));
+  SampleValues values;
+  readSample(values);
+  memcpy(rawFTData.data(), values.data() + FT_SENSOR_AXIS, sizeof(rawFTData));
   return 0;
 }
 
+/**
+ * @brief Encodes and sends a command, without waiting for its reply
+ * @param command Command to be sent
+ * @return Number of byte sent otherwise -1
+ */
+template <typename Command>
+int32_t FtSensorNew::sendCommand(const Command& command)
+{
+  CharBuff cb;
+  cb.size = encode(command, cb.content, sizeof(cb.content));
+  return commands.send(cb);
+}
+
+/**
+ * @brief Encodes and sends a command whose reply is awaited
+ * @param command Command to be sent
+ * @param replyId Id of the reply
+ * @param timeout Time after which the reply is given up
+ * @param accepts Filter of the messages with the id of the reply, none to accept all of them
+ * @return Future reply
+ */
+template <typename Command>
+std::future<CommandChannel::Reply> FtSensorNew::postCommand(const Command& command, uint16_t replyId,
+                                                            std::chrono::milliseconds timeout,
+                                                            CommandChannel::ReplyFilter accepts)
+{
+  CharBuff cb;
+  cb.size = encode(command, cb.content, sizeof(cb.content));
+  return commands.request(cb, {replyId}, timeout, std::move(accepts));
+}
+
+/**
+ * @brief Waits for the reply of a command and decodes it
+ * @param future Future reply returned by postCommand
+ * @param reply Decoded reply
+ * @param name Name of the reply, for the error messages
+ * @return true if the reply has been received before the timeout
+ */
+template <typename Reply>
+bool FtSensorNew::receiveReply(std::future<CommandChannel::Reply>& future, Reply& reply, const char* name)
+{
+  CommandChannel::Reply received = future.get();
+  if (received.size == 0 || decode(reply, received.content, received.size) < 0)
+  {
+    std::cerr << " recv " << name << " Error" << std::endl;
+    return false;
+  }
+  return true;
+}
+
 /**
    * @brief Sets all calibration offsets from sensor device
    */
 int32_t FtSensorNew::calibrateOffsets()
 {
-  CalibrateOffsets db;
-  cb.size = encode(db, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-  if (res < 0 )
+  // The board replies once the offsets have been computed; without reply the
+  // computation is given the time it was given before the reply was awaited
+  auto future = postCommand(CalibrateOffsets(), MESSAGE_ID__REPLY_CALIBRATE_OFFSETS, std::chrono::milliseconds{310});
+  ReplyCalibrateOffsets reply;
+  CommandChannel::Reply received = future.get();
+  if (received.size != 0 && decode(reply, received.content, received.size) > 0
+      && reply.getBrc() != BoardReturnCode_OK)
   {
-    std::cerr << "Send calibrateOffsets Error <<"<< res<<std::endl;
+    std::cerr << "calibrateOffsets Error <<"<< reply.getBrc() <<std::endl;
     return -1;
   }
 
   // Check that after calibration we're reading no offsets
   // for real. Cause sometimes if noise is very high calibration
-  // may not converge.
-  MILLISLEEP(310);
+  // may not converge. Wait for a sample taken after the calibration
+  auto calibrated = samples.lastSequence();
+  for (auto wait = 0; wait < 100 && samples.lastSequence() - calibrated < 2; ++wait)
+    MILLISLEEP(1);
 
   constexpr float maxForceAfterCalibration{50000.0};
   constexpr float maxForceAfterCalibrationImp{30000.0};
   constexpr float maxTorqueAfterCalibration{4500.0};
   constexpr float maxTorqueAfterCalibrationImp{3500.0};
 
-  std::lock_guard < std::mutex > lock(sensor_mutex);
-  if ( std::abs(this->Fx)  > maxForceAfterCalibration)
+  SampleValues values;
+  readSample(values);
+  if ( std::abs(values[0])  > maxForceAfterCalibration)
     return -1;
-  if ( std::abs(this->Fy) > maxForceAfterCalibration)
+  if ( std::abs(values[1]) > maxForceAfterCalibration)
     return -1;
-  if ( std::abs(this->Fz) > maxForceAfterCalibrationImp)
+  if ( std::abs(values[2]) > maxForceAfterCalibrationImp)
     return -1;
 
-  if ( std::abs(this->Tx) > maxTorqueAfterCalibrationImp)
+  if ( std::abs(values[3]) > maxTorqueAfterCalibrationImp)
     return -1;
-  if ( std::abs(this->Ty) > maxTorqueAfterCalibrationImp)
+  if ( std::abs(values[4]) > maxTorqueAfterCalibrationImp)
     return -1;
-  if ( std::abs(this->Tz) > maxTorqueAfterCalibration)
+  if ( std::abs(values[5]) > maxTorqueAfterCalibration)
     return -1;
 
   return 0;
@@ -152,29 +350,15 @@ int32_t FtSensorNew::calibrateOffsets()
    * @brief Gets all calibration offsets from sensor device
    * @param calibrationOffsets FTCalibrationOffsets array which
    *        contains all value of calibration offsets
+   * @return 0 means no errors
    */
-void FtSensorNew::getCalibrationOffsets(FTCalibrationOffsets &calibrationOffsets)
+int32_t FtSensorNew::getCalibrationOffsets(FTCalibrationOffsets &calibrationOffsets)
 {
-  GetCalibrationOffsets coff;
-  cb.size = encode(coff, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << "Send GetCalibrationOffsets Error <<"<< res<<std::endl;
-  }
+  auto future = postCommand(GetCalibrationOffsets(), MESSAGE_ID__REPLY_GET_CALIBRATION_OFFSETS);
 
   ReplyGetCalibrationOffsets rb;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << "Recv ReplyGetCalibrationOffsets Error <<"<< res<<std::endl;
-  }
-
-  decode(rb, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(rb.getHeaderId(), MESSAGE_ID__REPLY_CALIBRATE_OFFSETS);
+  if (!receiveReply(future, rb, "ReplyGetCalibrationOffsets"))
+    return -1;
 
   calibrationOffsets[0] = rb.getC0();
   calibrationOffsets[1] = rb.getC1();
@@ -182,7 +366,7 @@ void FtSensorNew::getCalibrationOffsets(FTCalibrationOffsets &calibrationOffsets
   calibrationOffsets[3] = rb.getC3();
   calibrationOffsets[4] = rb.getC4();
   calibrationOffsets[5] = rb.getC5();
-
+  return 0;
 }
 
 
@@ -190,47 +374,66 @@ void FtSensorNew::getCalibrationOffsets(FTCalibrationOffsets &calibrationOffsets
    * @brief FtSensorNew::setSampleStreamPol
    * @param pol SampleStreamPolicy value that can
    *        be 0 = OFF or 1 = normal
-   * @param rate rate in unit of half milliseconds
+   * @param rate rate in unit of half milliseconds, in [MIN_STREAM_RATE, MAX_STREAM_RATE]
+   *        when the stream is on
+   * @return 0 means no errors, -1 if the rate is out of the range of the driver or the board refuses it
    */
-void FtSensorNew::setSampleStreamPol(SampleStreamPolicy pol,
-                                     uint32_t rate)
+int32_t FtSensorNew::setSampleStreamPol(SampleStreamPolicy pol,
+                                        uint32_t rate)
 {
+  if (pol != SampleStreamPolicy_OFF && (rate < MIN_STREAM_RATE || rate > MAX_STREAM_RATE))
+  {
+    std::cerr << " SetSampleStreamPolicy rate " << rate << " out of range ["
+              << MIN_STREAM_RATE << ", " << MAX_STREAM_RATE << "]" << std::endl;
+    return -1;
+  }
+
   SetSampleStreamPolicy set;
   set.setPolicy(pol);
   set.setRate(rate);
-  cb.size = encode(set, cb.content,  sizeof(CharBuff));
-  bdm->sendTcpFromBoard(bdid, &cb);
+  auto future = postCommand(set, MESSAGE_ID__REPLY_SET_SAMPLE_STREAM_POLICY);
+
+  ReplySetSampleStreamPolicy rb;
+  if (!receiveReply(future, rb, "ReplySetSampleStreamPolicy"))
+    return -1;
+  if (rb.getBrc() != BoardReturnCode_OK)
+  {
+    std::cerr << " SetSampleStreamPolicy refused by the board, rate " << rate << std::endl;
+    return -1;
+  }
+  return 0;
 }
 
 /**
-   * @brief This function returns release version of the board
-   * @return Board release info
+   * @brief Reads back the stream policy of the board
+   * @param pol Current SampleStreamPolicy
+   * @return 0 means no errors
    */
-uint32_t FtSensorNew::getBoardInfo()
+int32_t FtSensorNew::getSampleStreamPol(SampleStreamPolicy &pol)
 {
-  GetBoardInfo gbi;
-  cb.size = encode(gbi, cb.content, sizeof(Ethservice::CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
+  auto future = postCommand(GetSampleStreamPolicy(), MESSAGE_ID__REPLY_GET_SAMPLE_STREAM_POLICY);
 
-  if (res == -1)
-  {
-    std::cerr << "Send GetBoardInfo Error <<"<< res<<std::endl;
-  }
-
-  ReplyBoardInfo rpl;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
+  ReplyGetSampleStreamPolicy rb;
+  if (!receiveReply(future, rb, "ReplyGetSampleStreamPolicy"))
+    return -1;
 
-  if (res == -1)
-  {
-    std::cerr << "Recv ReplyBoardInfo Error <<"<< res<<std::endl;
-  }
+  pol = rb.getPolicy();
+  return 0;
+}
 
-  decode(rpl, cb.content, cb.size);
+/**
+   * @brief This function returns release version of the board
+   * @return Board release info, 0 on error
+   */
+uint32_t FtSensorNew::getBoardInfo()
+{
+  auto future = postCommand(GetBoardInfo(), MESSAGE_ID__REPLY_BOARD_INFO);
 
-  auto result = checkMessageConsistency(rpl.getHeaderId(), MESSAGE_ID__REPLY_BOARD_INFO);
+  ReplyBoardInfo rpl;
+  if (!receiveReply(future, rpl, "ReplyBoardInfo"))
+    return 0;
 
   return rpl.getRelease();
-
 }
 
 /**
@@ -244,53 +447,80 @@ void FtSensorNew::setMtxRow(uint32_t row, FTSensorData &data)
   SetCalibrationMatrixRow set;
 
   set.setRow(row);
-  set.setC0(data[0]);
-  set.setC1(data[1]);
-  set.setC2(data[2]);
-  set.setC3(data[3]);
-  set.setC4(data[4]);
-  set.setC5(data[5]);
-  cb.size = encode(set, cb.content,  sizeof(CharBuff));
-  bdm->sendTcpFromBoard(bdid, &cb);
-
+  set.setCoefficients(data.data());
+  sendCommand(set);
 }
 
 /**
-    * @brief This function get data from Sensor and put them in to Matrix
+    * @brief Sends the request of a row of the calibration matrix
     * @param row Row of matrix calibration
-    * @param mtxRow FTSensorData array which contains all value of force in N
-    *        and torque in Nm
+    * @return Future reply
     */
-void FtSensorNew::getMtxRow(uint32_t row, FTSensorData &mtxRow)
+std::future<CommandChannel::Reply> FtSensorNew::requestMtxRow(uint32_t row)
 {
   GetCalibrationMatrixRow coff;
   coff.setRow(row);
-  cb.size = encode(coff, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " Send GetCalibrationMatrixRow Error"<<std::endl;
-  }
+  // the rows in flight share the id of their reply: a late reply must not be taken for another row
+  return postCommand(coff, MESSAGE_ID__REPLY_GET_CALIBRATION_MATRIX_ROW, COMMAND_TIMEOUT,
+                     [row](const CommandChannel::Reply& reply) {
+                       ReplyGetCalibrationMatrixRow rb;
+                       return decode(rb, reply.content, reply.size) >= 0 && rb.getRow() == row;
+                     });
+}
 
+/**
+    * @brief Decodes the reply of requestMtxRow
+    * @param future Future reply
+    * @param row Row requested
+    * @param mtxRow FTSensorData array which contains the row
+    * @return 0 means no errors
+    */
+int32_t FtSensorNew::receiveMtxRow(std::future<CommandChannel::Reply>& future, uint32_t row, FTSensorData &mtxRow)
+{
   ReplyGetCalibrationMatrixRow rb;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
+  if (!receiveReply(future, rb, "ReplyGetCalibrationMatrixRow"))
+    return -1;
+  if (rb.getRow() != row)
   {
-    std::cerr << " recv ReplyGetCalibrationMatrixRow Error"<<std::endl;
+    std::cerr << " recv ReplyGetCalibrationMatrixRow row " << rb.getRow() << " instead of " << row << std::endl;
+    return -1;
   }
 
-  decode(rb, cb.content, cb.size);
+  memcpy(mtxRow.data(), rb.getCoefficients(), sizeof(mtxRow));
+  return 0;
+}
 
-  auto result = checkMessageConsistency(rb.getHeaderId(), MESSAGE_ID__REPLY_GET_CALIBRATION_MATRIX_ROW);
+/**
+    * @brief This function get data from Sensor and put them in to Matrix
+    * @param row Row of matrix calibration
+    * @param mtxRow FTSensorData array which contains all value of force in N
+    *        and torque in Nm
+    * @return 0 means no errors
+    */
+int32_t FtSensorNew::getMtxRow(uint32_t row, FTSensorData &mtxRow)
+{
+  auto future = requestMtxRow(row);
+  return receiveMtxRow(future, row, mtxRow);
+}
+
+/**
+    * @brief Gets the whole calibration matrix, with all the requests in flight at once
+    * @param matrix Rows of the calibration matrix
+    * @return 0 means no errors
+    */
+int32_t FtSensorNew::getCalibrationMatrix(CalibrationMatrix &matrix)
+{
+  std::array<std::future<CommandChannel::Reply>, FT_SENSOR_AXIS> rows;
+  for (size_t row = 0; row < FT_SENSOR_AXIS; ++row)
+    rows[row] = requestMtxRow(row);
 
-  mtxRow[0] = rb.getC0();
-  mtxRow[1] = rb.getC1();
-  mtxRow[2] = rb.getC2();
-  mtxRow[3] = rb.getC3();
-  mtxRow[4] = rb.getC4();
-  mtxRow[5] = rb.getC5();
+  int32_t result = 0;
+  for (size_t row = 0; row < FT_SENSOR_AXIS; ++row)
+  {
+    if (receiveMtxRow(rows[row], row, matrix[row]) != 0)
+      result = -1;
+  }
+  return result;
 }
 
 /**
@@ -298,9 +528,7 @@ void FtSensorNew::getMtxRow(uint32_t row, FTSensorData &mtxRow)
     */
 void FtSensorNew::saveParamsOnFlash()
 {
-  SaveParamsOnFlash sv;
-  cb.size = encode(sv, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
+  auto res = sendCommand(SaveParamsOnFlash());
 
   if (res == -1)
   {
@@ -317,41 +545,22 @@ void FtSensorNew::setIpAddress(uint32_t ipAddress)
 {
   SetIpAddress set;
   set.setIpAddress(ntohl(ipAddress));
-  cb.size = encode(set, cb.content,  sizeof(CharBuff));
-  bdm->sendTcpFromBoard(bdid, &cb);
-
+  sendCommand(set);
 }
 
 /**
  * @brief Gets IP address of board
- * @return Value of address IP of sensor
+ * @return Value of address IP of sensor, 0 on error
  */
 uint32_t FtSensorNew::getIpAddress()
 {
-  GetIpAddress ipAddr;
-  cb.size = encode(ipAddr, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " Send getIpAddress Error"<<std::endl;
-  }
+  auto future = postCommand(GetIpAddress(), MESSAGE_ID__REPLY_GET_IP_ADDRESS);
 
   ReplyGetIpAddress ra;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " recv ReplyGetIpAddress Error"<<std::endl;
-  }
-
-  decode(ra, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(ra.getHeaderId(), MESSAGE_ID__REPLY_GET_IP_ADDRESS);
+  if (!receiveReply(future, ra, "ReplyGetIpAddress"))
+    return 0;
 
   return ra.getIpAddress();
-
-
 }
 
 
@@ -374,14 +583,11 @@ Multitorque::MacAddressReturnCode FtSensorNew::setMacAddress(MacAddress &macArra
   set.setM6(0);
   set.setM7(0);
 
-  cb.size = encode(set, cb.content,  sizeof(CharBuff));
-  bdm->sendTcpFromBoard(bdid, &cb);
+  auto future = postCommand(set, MESSAGE_ID__REPLY_SET_MAC_ADDRESS);
 
   ReplySetMacAddress rsmac;
-  bdm->recvTcpFromBoard(bdid, &cb);
-  decode(rsmac, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(rsmac.getHeaderId(), MESSAGE_ID__REPLY_SET_MAC_ADDRESS);
+  if (!receiveReply(future, rsmac, "ReplySetMacAddress"))
+    return MacAddressReturnCode_ERR;
 
   return (rsmac.getMacrc());
 }
@@ -390,30 +596,15 @@ Multitorque::MacAddressReturnCode FtSensorNew::setMacAddress(MacAddress &macArra
  * @brief Gets MAC address of board
  * @param macArray Array wich contains Mac address ( e.g macArray[] = 00 ,
  *        macArray[1] = 11 etc)
+ * @return 0 means no errors
  */
-void FtSensorNew::getMacAddress(MacAddress &macArray)
+int32_t FtSensorNew::getMacAddress(MacAddress &macArray)
 {
-
-  GetMacAddress mac;
-  cb.size = encode(mac, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " Send getMacAddress Error"<<std::endl;
-  }
+  auto future = postCommand(GetMacAddress(), MESSAGE_ID__REPLY_GET_MAC_ADDRESS);
 
   ReplyGetMacAddress ra;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " recv ReplyGetIpAddress Error"<<std::endl;
-  }
-
-  decode(ra, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(ra.getHeaderId(), MESSAGE_ID__REPLY_GET_MAC_ADDRESS);
+  if (!receiveReply(future, ra, "ReplyGetMacAddress"))
+    return -1;
 
   macArray[0] = ra.getM0();
   macArray[1] = ra.getM1();
@@ -423,6 +614,7 @@ void FtSensorNew::getMacAddress(MacAddress &macArray)
   macArray[5] = ra.getM5();
   macArray[6] = ra.getM6();
   macArray[7] = ra.getM7();
+  return 0;
 }
 
 /**
@@ -433,36 +625,20 @@ void FtSensorNew::setNetmask(uint32_t netmask)
 {
   SetNetmask sn;
   sn.setNetmask(ntohl(netmask));
-  cb.size = encode(sn, cb.content,  sizeof(CharBuff));
-  bdm->sendTcpFromBoard(bdid, &cb);
+  sendCommand(sn);
 }
 
 /**
  * @brief Gets Net Mask address of board
- * @return Value of net mask
+ * @return Value of net mask, 0 on error
  */
 uint32_t FtSensorNew::getNetmask()
 {
-  GetNetmask netmask;
-  cb.size = encode(netmask, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " Send getNetMask Error"<<std::endl;
-  }
+  auto future = postCommand(GetNetmask(), MESSAGE_ID__REPLY_GET_NETMASK);
 
   ReplyGetNetmask rgn;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " recv getNetMask Error"<<std::endl;
-  }
-
-  decode(rgn, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(rgn.getHeaderId(), MESSAGE_ID__REPLY_GET_NETMASK);
+  if (!receiveReply(future, rgn, "ReplyGetNetmask"))
+    return 0;
 
   //i need to use htonl to move host long to network
   return htonl(rgn.getNetmask());
@@ -477,37 +653,20 @@ void FtSensorNew::setGateway(uint32_t gateway)
 {
   SetGateway sg;
   sg.setGateway(ntohl(gateway));
-  cb.size = encode(sg, cb.content,  sizeof(CharBuff));
-  bdm->sendTcpFromBoard(bdid, &cb);
-
+  sendCommand(sg);
 }
 
 /**
  * @brief Sets Gateway address of board
- * @return Gateway address of board
+ * @return Gateway address of board, 0 on error
  */
 uint32_t FtSensorNew::getGateway()
 {
-  GetGateway gateway;
-  cb.size = encode(gateway, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " Send getGateWay Error"<<std::endl;
-  }
+  auto future = postCommand(GetGateway(), MESSAGE_ID__REPLY_GET_GATEWAY);
 
   ReplyGetGateway rgw;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " recv getGateWay Error"<<std::endl;
-  }
-
-  decode(rgw, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(rgw.getHeaderId(), MESSAGE_ID__REPLY_GET_GATEWAY);
+  if (!receiveReply(future, rgw, "ReplyGetGateway"))
+    return 0;
 
   //i need to use htonl to move host long to network
   return htonl(rgw.getGateway());
@@ -518,30 +677,15 @@ uint32_t FtSensorNew::getGateway()
  *        from flash memory
  * @param inventoryData Array of int32 which contains
  *        all inventory data
- * @return Data Inventory read from flash
+ * @return 0 means no errors
  */
 uint32_t FtSensorNew::readInventory(InventoryData& inventoryData)
 {
-  LoadInventoryDataFromFlash inv;
-  cb.size = encode(inv, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " Send LoadInventoryDataOnFlash Error"<<std::endl;
-  }
+  auto future = postCommand(LoadInventoryDataFromFlash(), MESSAGE_ID__REPLY_LOAD_INVENTORY_DATA_FROM_FLASH);
 
   ReplyLoadInventoryDataFromFlash rinv;
-  res = bdm->recvTcpFromBoard(bdid, &cb);
-
-  if (res == -1)
-  {
-    std::cerr << " recv ReplyReadInventory Error"<<std::endl;
-  }
-
-  decode(rinv, cb.content, cb.size);
-
-  auto result = checkMessageConsistency(rinv.getHeaderId(), MESSAGE_ID__REPLY_LOAD_INVENTORY_DATA_FROM_FLASH);
+  if (!receiveReply(future, rinv, "ReplyLoadInventoryDataFromFlash"))
+    return -1;
 
   inventoryData[0] = rinv.getDesignCode();
   inventoryData[1] = rinv.getBoardVer();
@@ -570,8 +714,7 @@ uint32_t FtSensorNew::writeInventory(uint32_t designCode, uint32_t boardVer,
   inv.setBoardRev(boardRev);
   inv.setSerialNumber(serialNumber);
   inv.setDateTime(dateTime);
-  cb.size = encode(inv, cb.content,  sizeof(CharBuff));
-  auto res = bdm->sendTcpFromBoard(bdid, &cb);
+  auto res = sendCommand(inv);
 
   if (res == -1)
   {
@@ -581,5 +724,3 @@ uint32_t FtSensorNew::writeInventory(uint32_t designCode, uint32_t boardVer,
   return 0;
 }
 }
-
-
@@ -15,8 +15,11 @@
 #include <string>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include "Multitorque.h"
 #include "ethService.h"
+#include "commandChannel.h"
+#include "ftSampleRing.h"
 #include "rehab.h"
 #include "osutil.h"
 
@@ -33,36 +36,91 @@ class FtSensorNew final
 {
 public:
 
-  FtSensorNew(Ethservice::EthInterfaceManager* bdm_, board_id_t bdid_);
-  ~FtSensorNew() ;
-
   /* Constants definitions */
   static constexpr const size_t FT_SENSOR_AXIS   = 6;
+  ///Default number of samples kept in the history
+  static constexpr const size_t DEFAULT_HISTORY_SIZE   = 1000;
+  ///Range of the stream rate requested by the driver, in half milliseconds (0.5 ms to 1 s):
+  ///a policy of the driver, the board does not report the rates it supports
+  static constexpr const uint32_t MIN_STREAM_RATE   = 1;
+  static constexpr const uint32_t MAX_STREAM_RATE   = 2000;
+  ///Values of a broadcast sample: force and torque (in thousandths of N and Nm), then raw channels
+  static constexpr const size_t SAMPLE_VALUES   = 2 * FT_SENSOR_AXIS;
+
+  FtSensorNew(Ethservice::EthInterfaceManager* bdm_, board_id_t bdid_,
+              size_t historySize = DEFAULT_HISTORY_SIZE);
+  ~FtSensorNew() ;
 
   /* Type definitions */
   ///Array of float which contains force and torque for every three axis
   using FTSensorData = std::array< float, FT_SENSOR_AXIS > ;
   ///Array of float which contains all calibration data
   using FTCalibrationOffsets = std::array< uint32_t, FT_SENSOR_AXIS > ;
+  ///Rows of the calibration matrix
+  using CalibrationMatrix = std::array< FTSensorData, FT_SENSOR_AXIS > ;
+  ///Time after which the reply of a command is given up
+  static constexpr const std::chrono::milliseconds COMMAND_TIMEOUT{500};
+  ///Default age after which the last sample is stale
+  static constexpr const std::chrono::milliseconds DEFAULT_MAX_SAMPLE_AGE{100};
+  ///Number of samples over which the rate is measured
+  static constexpr const uint64_t RATE_WINDOW = 100;
+
+  ///Sample as broadcast by the board, with its receive time and number
+  using TimedSample = FtSampleRing< SAMPLE_VALUES >::TimedSample;
+
+  ///Force and torque of a sample, with the time it has been received at
+  struct TimedFTData
+  {
+    uint64_t sequence;   ///< number of the sample, from 1
+    double timestamp;    ///< receive time in seconds since the epoch
+    FTSensorData ftData;
+  };
+
+  /// Counters of the datagrams broadcast by the sensor
+  struct DatagramStatistics
+  {
+    uint64_t received;  ///< valid samples
+    uint64_t malformed; ///< datagrams too short or with an invalid header
+    uint64_t wrongId;   ///< datagrams carrying another message
+  };
+
+  /// Liveness of the sensor, computed when requested from the samples kept
+  struct Liveness
+  {
+    bool alive;               ///< a sample has been received within the max sample age
+    double lastSampleAge;     ///< seconds since the last sample was received, infinity if none
+    double observedRate;      ///< samples per second over the last RATE_WINDOW samples, 0 if less than 2
+    uint64_t missedDeadlines; ///< timeouts of the manager without samples, since the first sample
+  };
 
   int32_t getFTData (FTSensorData &ftData);
+  int32_t getFTData (FTSensorData &ftData, double &timestamp, uint64_t &sequence);
+  uint64_t getFTHistory (uint64_t &cursor, std::vector<TimedFTData> &history);
   int32_t getRawFTData (FTSensorData &rawFTData);
-  void setSampleStreamPol(Multitorque::SampleStreamPolicy pol, uint32_t rate);
+  int32_t getLatestSample (TimedSample &sample);
+  int32_t setSampleStreamPol(Multitorque::SampleStreamPolicy pol, uint32_t rate);
+  int32_t getSampleStreamPol(Multitorque::SampleStreamPolicy &pol);
   int32_t calibrateOffsets() ;
-  void getCalibrationOffsets(FTCalibrationOffsets &calibrationOffsets);
+  int32_t getCalibrationOffsets(FTCalibrationOffsets &calibrationOffsets);
 
   void setMtxRow(uint32_t row, FTSensorData &data);
-  void getMtxRow(uint32_t row, FTSensorData &mtxRow);
+  int32_t getMtxRow(uint32_t row, FTSensorData &mtxRow);
+  std::future<CommandChannel::Reply> requestMtxRow(uint32_t row);
+  int32_t receiveMtxRow(std::future<CommandChannel::Reply>& future, uint32_t row, FTSensorData &mtxRow);
+  int32_t getCalibrationMatrix(CalibrationMatrix &matrix);
   void saveParamsOnFlash();
   uint32_t getBoardInfo();
 
-  bool isConnectivityOk();
+  bool isConnectivityOk() const;
+  Liveness getLiveness() const;
+  void setMaxSampleAge(std::chrono::milliseconds maxAge);
+  DatagramStatistics getDatagramStatistics() const;
 
 
   // Network parameters management
   void setIpAddress(uint32_t ipAddress);
   Multitorque::MacAddressReturnCode setMacAddress(MacAddress &macArray);
-  void getMacAddress(MacAddress &macArray);
+  int32_t getMacAddress(MacAddress &macArray);
   uint32_t getIpAddress();
   void setNetmask(uint32_t ipAddress);
   void setGateway(uint32_t gateway);
@@ -80,22 +138,35 @@ public:
 
 
 private:
-  mutable std::mutex sensor_mutex;
+  using SampleValues = std::array< float, SAMPLE_VALUES > ;
 
-  void analyzePacketSensor(const Ethservice::CharBuff* packetToReceive);
+  void analyzePacketSensor(const Ethservice::CharBuff* packetToReceive, Ethservice::receiveTime_t receiveTime);
+  void readSample(SampleValues &values) const;
+  double lastSampleAge() const;
+
+  template <typename Command>
+  int32_t sendCommand(const Command& command);
+  template <typename Command>
+  std::future<CommandChannel::Reply> postCommand(const Command& command, uint16_t replyId,
+                                                 std::chrono::milliseconds timeout = COMMAND_TIMEOUT,
+                                                 CommandChannel::ReplyFilter accepts = CommandChannel::ReplyFilter());
+  template <typename Reply>
+  bool receiveReply(std::future<CommandChannel::Reply>& future, Reply& reply, const char* name);
 
-  Ethservice::CharBuff cb;
   Ethservice::EthInterfaceManager* bdm;
   const board_id_t bdid;
+  CommandChannel commands;
+
+  // Last samples, written by the receiving thread only
+  FtSampleRing< SAMPLE_VALUES > samples;
 
+  std::atomic< uint64_t > receivedDatagrams{0};
+  std::atomic< uint64_t > malformedDatagrams{0};
+  std::atomic< uint64_t > wrongIdDatagrams{0};
 
-  float Fx = 0;
-  float Fy = 0;
-  float Fz = 0;
-  float Tx = 0;
-  float Ty = 0;
-  float Tz = 0;
-  FTSensorData raw;
+  // Counted by the thread of the manager, when it finds the board silent
+  std::atomic< uint64_t > missedDeadlines{0};
+  std::atomic< std::chrono::milliseconds::rep > maxSampleAge{DEFAULT_MAX_SAMPLE_AGE.count()};
 };
 }
 
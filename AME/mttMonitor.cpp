@@ -112,15 +112,16 @@ int checkArguments (int argc, char *argv[])
 
 /**
  * @brief This function allow the connction from pc to board
+ * @param bdm2 Manager of the local interface, to be kept while the sensor is used
+ * @param ftBoard Identifier of the board in the manager
  * @return shared pointer of FtSensorNew class
  */
-std::shared_ptr<rehab::FtSensorNew> connect()
+std::shared_ptr<rehab::FtSensorNew> connect(std::shared_ptr<Ethservice::EthInterfaceManager>& bdm2, board_id_t& ftBoard)
 {
 
   //Device Connection
-  //TODO FIX IT this static is shit
-  static auto bdm2= std::make_shared<Ethservice::EthInterfaceManager>(optionArgument.ipAddress,64321);
-  auto ftBoard = bdm2->addBoard(optionArgument.deviceAddress, true, 64321, true, 64321);
+  bdm2 = Ethservice::EthInterfaceManager::acquire(optionArgument.ipAddress,64321);
+  ftBoard = bdm2->addBoard(optionArgument.deviceAddress, true, 64321, true, 64321);
   auto rc = bdm2->connectAll();
   if ( !rehab::isRCOk(rc) )
   {
@@ -159,6 +160,10 @@ int readSensorUtility(rehab::FtSensorNew* ftSensor)
     mvprintw(6,2,"fz    % 04.2f\t  tz   % 04.2f               ",  ftc2[2], ftc2[5] );
     mvprintw(8,2,"raw % 06.0f % 06.0f % 06.0f % 06.0f % 06.0f % 06.0f                                           ",
              ftcRaw[0], ftcRaw[1],ftcRaw[2], ftcRaw[3],ftcRaw[4],ftcRaw[5]);
+    auto liveness = ftSensor->getLiveness();
+    mvprintw(9,2,"%s  age % 8.1f ms  rate % 7.1f Hz  missed %llu               ",
+             liveness.alive ? "ALIVE  " : "TIMEOUT", liveness.lastSampleAge * 1000, liveness.observedRate,
+             static_cast<unsigned long long>(liveness.missedDeadlines));
     mvprintw(10,2,"Calibration Result : %d ", calibResult);
     mvprintw(12, 2,  " a - READ MtxRow");
     mvprintw(12, 20, " g - READ CalibOffset");
@@ -186,10 +191,11 @@ int readSensorUtility(rehab::FtSensorNew* ftSensor)
     if (ch == 'a')
     {
       clear();
+      rehab::FtSensorNew::CalibrationMatrix matrix;
+      ftSensor->getCalibrationMatrix(matrix);
       for (auto i : {0,1,2,3,4,5})
       {
-        rehab::FtSensorNew::FTSensorData row;
-        ftSensor->getMtxRow(i, row);
+        auto& row = matrix[i];
         mvprintw(16+i, 4, " %f %f %f %f %f %f", row[0], row[1],row[2],
             row[3],row[4],row[5]);
       }
@@ -232,8 +238,12 @@ int main(int argc, char *argv[])
   //Check connection
   if(!optionArgument.helpOption)
   {
-    auto ftSensorObj = connect();
+    std::shared_ptr<Ethservice::EthInterfaceManager> manager;
+    board_id_t board;
+    auto ftSensorObj = connect(manager, board);
     res = readSensorUtility(ftSensorObj.get());
+    // the receive thread must be done with the handlers of the sensor before it is destroyed
+    manager->removeBoard(board);
     if (res != 0)
     {
       std::cerr << "Error on execution command " << std::endl;
@@ -0,0 +1,93 @@
+// Compares the decoding rate of BCastSensorData packets between the message codec
+// (MultitorqueCodec.h) and the field by field decoding it replaced.
+
+#include "MultitorqueEncoder.h"
+#include "baseTypeEncoding.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Multitorque;
+
+namespace
+{
+
+// Field by field decoding, as formerly done for every message
+int32_t decodeFieldByField(BCastSensorData& message, const uint8_t* binary, const size_t maxSize)
+{
+  int32_t bytes = 0;
+  int32_t retCode = 0;
+
+  LIBHeader h;
+  retCode = decode(h, binary, maxSize);
+  if(retCode < 0)
+    return retCode;
+  bytes += retCode;
+  message.setHeader(h);
+
+  void (BCastSensorData::*setters[])(const float&) = {
+    &BCastSensorData::setFx, &BCastSensorData::setFy, &BCastSensorData::setFz,
+    &BCastSensorData::setTx, &BCastSensorData::setTy, &BCastSensorData::setTz,
+    &BCastSensorData::setRaw0, &BCastSensorData::setRaw1, &BCastSensorData::setRaw2,
+    &BCastSensorData::setRaw3, &BCastSensorData::setRaw4, &BCastSensorData::setRaw5
+  };
+  for(unsigned i = 0; i < sizeof(setters) / sizeof(setters[0]); ++i)
+  {
+    float value;
+    retCode = LIB::decode(value, &(binary[bytes]), (size_t)(maxSize - bytes));
+    if(retCode < 0)
+      return retCode;
+    bytes += retCode;
+    (message.*setters[i])(value);
+  }
+
+  return bytes;
+}
+
+template <typename Decoder>
+double packetsPerSecond(Decoder decoder, const uint8_t* packet, const size_t size, const unsigned long iterations, float& checksum)
+{
+  BCastSensorData message;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(unsigned long i = 0; i < iterations; ++i)
+  {
+    decoder(message, packet, size);
+    checksum += message.getFz();
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return iterations / elapsed;
+}
+
+int32_t decodeWithCodec(BCastSensorData& message, const uint8_t* binary, const size_t maxSize)
+{
+  return decode(message, binary, maxSize);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned long iterations = argc > 1 ? strtoul(argv[1], 0, 10) : 10000000;
+
+  BCastSensorData data;
+  data.setFx(1.f); data.setFy(2.f); data.setFz(3.f);
+  data.setTx(.1f); data.setTy(.2f); data.setTz(.3f);
+  uint8_t packet[256];
+  int32_t size = encode(data, packet, sizeof(packet));
+  if(size < 0)
+  {
+    printf("Failed to encode the packet\n");
+    return 1;
+  }
+
+  float checksum = 0;
+  double fieldByField = packetsPerSecond(decodeFieldByField, packet, size, iterations, checksum);
+  double codec = packetsPerSecond(decodeWithCodec, packet, size, iterations, checksum);
+
+  printf("BCastSensorData decoding (%lu packets)\n", iterations);
+  printf("  field by field: %.3g packets/s\n", fieldByField);
+  printf("  codec:          %.3g packets/s (x%.1f)\n", codec, codec / fieldByField);
+  printf("  (checksum %g)\n", checksum);
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <dirent.h>
 #include <sys/stat.h>
 #include <thread>
+#include <unistd.h>
 
 namespace rehab {
 
@@ -0,0 +1,9 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#include "IMultipleNetFTSensors.h"
+
+yarp::dev::IMultipleNetFTSensors::~IMultipleNetFTSensors() {}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef IMULTIPLENETFTSENSORS_H
+#define IMULTIPLENETFTSENSORS_H
+
+#include <string>
+#include <yarp/sig/Vector.h>
+#include <yarp/os/Stamp.h>
+
+namespace yarp {
+namespace dev {
+    class IMultipleNetFTSensors;
+}
+}
+
+class yarp::dev::IMultipleNetFTSensors
+{
+public:
+
+    /**
+     * Virtual destructor
+     */
+    virtual ~IMultipleNetFTSensors();
+
+    /**
+     * Returns the number of Net F/T sensors handled by the device
+     * @returns the number of sensors
+     */
+    virtual int getNumberOfSensors() = 0;
+
+    /**
+     * Return the index corresponding to the sensor identified by the specified parameter
+     * @param sensorID id of the sensor
+     * @return the index of the sensor or -1 if not found
+     */
+    virtual int getSensorIndexForSensorID(const std::string& sensorID) = 0;
+
+    /**
+     * Get the last wrench received from the sensor at the specified index
+     *
+     * @param[in] sensorIndex index of the sensor
+     * @param[out] measurement vector filled with the last wrench (forces and torques in the output frame)
+     * @param[out] timestamp timestamp associated with the last measure. Pass NULL if not interested in the timestamp
+     * @return the status of the measure as in yarp::dev::IAnalogSensor
+     */
+    virtual int getLastMeasurementForSensorAtIndex(const unsigned sensorIndex,
+                                                   yarp::sig::Vector& measurement,
+                                                   yarp::os::Stamp *timestamp) = 0;
+
+};
+
+#endif // IMULTIPLENETFTSENSORS_H
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#include "ati_calibration.h"
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Searchable.h>
+#include <yarp/os/Bottle.h>
+
+#include <tinyxml.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+    const char *AXES[] = { "FX", "Fy", "Fz", "Tx", "Ty", "Tz" }; /* The names of the force and torque axes, as in the file */
+
+    const TiXmlElement* findEntry(TiXmlHandle &root, const char *table, const char *entry)
+    {
+        return root.FirstChildElement(table).FirstChildElement(entry).ToElement();
+    }
+
+    bool readString(TiXmlHandle &root, const char *table, const char *entry, std::string &value)
+    {
+        const TiXmlElement *element = findEntry(root, table, entry);
+        if (!element || !element->GetText()) {
+            return false;
+        }
+        value = element->GetText();
+        return true;
+    }
+
+    /* Parse exactly `size` whitespace separated numbers */
+    bool readNumbers(TiXmlHandle &root, const char *table, const char *entry, double *values, int size)
+    {
+        std::string text;
+        if (!readString(root, table, entry, text)) {
+            return false;
+        }
+        const char *cursor = text.c_str();
+        for (int i = 0; i < size; ++i) {
+            char *end = 0;
+            values[i] = std::strtod(cursor, &end);
+            if (end == cursor) {
+                return false;
+            }
+            cursor = end;
+        }
+        // Nothing but spaces allowed after the last number
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') {
+            cursor++;
+        }
+        return *cursor == '\0';
+    }
+
+    void rpyToRotation(double roll, double pitch, double yaw, double R[3][3])
+    {
+        const double cr = std::cos(roll), sr = std::sin(roll);
+        const double cp = std::cos(pitch), sp = std::sin(pitch);
+        const double cy = std::cos(yaw), sy = std::sin(yaw);
+        // R = Rz(yaw) * Ry(pitch) * Rx(roll)
+        R[0][0] = cy * cp; R[0][1] = cy * sp * sr - sy * cr; R[0][2] = cy * sp * cr + sy * sr;
+        R[1][0] = sy * cp; R[1][1] = sy * sp * sr + cy * cr; R[1][2] = sy * sp * cr - cy * sr;
+        R[2][0] = -sp;     R[2][1] = cp * sr;                R[2][2] = cp * cr;
+    }
+
+    void multiply(const double A[6][6], const double B[6][6], double out[6][6])
+    {
+        for (int i = 0; i < 6; ++i) {
+            for (int j = 0; j < 6; ++j) {
+                double value = 0.0;
+                for (int k = 0; k < 6; ++k) {
+                    value += A[i][k] * B[k][j];
+                }
+                out[i][j] = value;
+            }
+        }
+    }
+
+    bool readList(yarp::os::Searchable &config, const std::string &name, double *values, size_t size)
+    {
+        yarp::os::Bottle *list = config.find(name).asList();
+        if (!list || list->size() != size) {
+            return false;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            values[i] = list->get(i).asFloat64();
+        }
+        return true;
+    }
+}
+
+bool ati_rdt::loadCalibrationFile(const std::string &fileName, NetFTCalibration &calibration, std::string &error)
+{
+    TiXmlDocument calibFile(fileName);
+    if (!calibFile.LoadFile()) {
+        error = "could not load " + fileName + ": " + calibFile.ErrorDesc();
+        return false;
+    }
+
+    TiXmlHandle document(&calibFile);
+    TiXmlHandle root = document.FirstChildElement("dsNetFTCalibrationFile");
+    if (!root.ToElement()) {
+        error = "dsNetFTCalibrationFile element not found";
+        return false;
+    }
+
+    const char *info = "tblNetFTCalibrationInfo";
+    const char *units = "tblCalibrationInformation";
+
+    for (int i = 0; i < 6; ++i) {
+        std::string entry = std::string("Matrix") + AXES[i];
+        if (!readNumbers(root, info, entry.c_str(), calibration.gaugeMatrix[i], 6)) {
+            error = "missing or malformed " + entry + " (6 numbers expected)";
+            return false;
+        }
+    }
+
+    double counts;
+    if (!readNumbers(root, units, "CountsPerForce", &counts, 1) || counts <= 0) {
+        error = "missing or invalid CountsPerForce";
+        return false;
+    }
+    calibration.countsPerForce = counts;
+    if (!readNumbers(root, units, "CountsPerTorque", &counts, 1) || counts <= 0) {
+        error = "missing or invalid CountsPerTorque";
+        return false;
+    }
+    calibration.countsPerTorque = counts;
+
+    // Optional entries
+    readString(root, info, "SerialNumber", calibration.serialNumber);
+    readString(root, info, "BodyStyle", calibration.bodyStyle);
+    readString(root, info, "CalibrationPartNumber", calibration.calibrationPartNumber);
+    readString(root, info, "Family", calibration.family);
+    readString(root, info, "CalibrationDate", calibration.calibrationDate);
+    readString(root, units, "ForceUnits", calibration.forceUnits);
+    readString(root, units, "TorqueUnits", calibration.torqueUnits);
+    if (!readNumbers(root, info, "GaugeGains", calibration.gaugeGains, 6)) {
+        for (int i = 0; i < 6; ++i) calibration.gaugeGains[i] = 0;
+    }
+    if (!readNumbers(root, info, "GaugeOffsets", calibration.gaugeOffsets, 6)) {
+        for (int i = 0; i < 6; ++i) calibration.gaugeOffsets[i] = 0;
+    }
+    if (!readNumbers(root, units, "MaxRatings", calibration.maxRatings, 6)) {
+        for (int i = 0; i < 6; ++i) calibration.maxRatings[i] = 0;
+    }
+
+    return true;
+}
+
+ati_rdt::WrenchTransform::WrenchTransform()
+{
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            m_matrix[i][j] = (i == j) ? 1.0 : 0.0;
+        }
+    }
+}
+
+void ati_rdt::WrenchTransform::build(const NetFTCalibration &calibration, const double *toolTransform, const double *outputRotation)
+{
+    // Counts to force/torque units. The RDT records already contain force/torque counts:
+    // the gauge matrix of the calibration file is applied inside the Net F/T.
+    double scaling[6][6] = {};
+    for (int i = 0; i < 3; ++i) {
+        scaling[i][i] = 1.0 / calibration.countsPerForce;
+        scaling[i + 3][i + 3] = 1.0 / calibration.countsPerTorque;
+    }
+
+    // Tool transform: wrench expressed in the tool frame and with the torque about the tool origin
+    // f_t = R^T f_s, m_t = R^T (m_s - d x f_s)
+    double tool[6][6] = {};
+    if (toolTransform) {
+        const double deg2rad = M_PI / 180.0;
+        double R[3][3];
+        rpyToRotation(toolTransform[3] * deg2rad, toolTransform[4] * deg2rad, toolTransform[5] * deg2rad, R);
+        const double *d = toolTransform;
+        const double skewD[3][3] = { {    0, -d[2],  d[1] },
+                                     { d[2],     0, -d[0] },
+                                     {-d[1],  d[0],     0 } };
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                tool[i][j] = R[j][i];
+                tool[i + 3][j + 3] = R[j][i];
+                double value = 0.0;
+                for (int k = 0; k < 3; ++k) {
+                    value += R[k][i] * skewD[k][j];
+                }
+                tool[i + 3][j] = -value;
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < 6; ++i) tool[i][i] = 1.0;
+    }
+
+    // Rotation to the output frame, applied to both force and torque
+    double output[6][6] = {};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            double value = outputRotation ? outputRotation[3 * i + j] : (i == j ? 1.0 : 0.0);
+            output[i][j] = value;
+            output[i + 3][j + 3] = value;
+        }
+    }
+
+    double toolScaling[6][6];
+    multiply(tool, scaling, toolScaling);
+    multiply(output, toolScaling, m_matrix);
+}
+
+bool ati_rdt::WrenchTransform::configure(const NetFTCalibration &calibration, yarp::os::Searchable &config, const std::string &logPrefix)
+{
+    double toolTransform[6];
+    bool useToolTransform = config.check("toolTransform");
+    if (useToolTransform && !readList(config, "toolTransform", toolTransform, 6)) {
+        yError() << logPrefix << "toolTransform should be a list of 6 values (x y z roll pitch yaw)";
+        return false;
+    }
+
+    double outputRotation[9];
+    bool useOutputRotation = config.check("sensorToOutputRotation");
+    if (useOutputRotation && !readList(config, "sensorToOutputRotation", outputRotation, 9)) {
+        yError() << logPrefix << "sensorToOutputRotation should be a row-major 3x3 rotation matrix (9 values)";
+        return false;
+    }
+
+    build(calibration, useToolTransform ? toolTransform : 0, useOutputRotation ? outputRotation : 0);
+    return true;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef YARP_ati_calibration_H
+#define YARP_ati_calibration_H
+
+#include <stdint.h>
+#include <string>
+
+namespace yarp {
+namespace os {
+    class Searchable;
+}
+}
+
+namespace ati_rdt {
+
+/**
+ * Content of a Net F/T calibration file (dsNetFTCalibrationFile, as downloaded from the box)
+ */
+struct NetFTCalibration {
+    // tblNetFTCalibrationInfo
+    std::string serialNumber;
+    std::string bodyStyle;
+    std::string calibrationPartNumber;
+    std::string family;
+    std::string calibrationDate;
+    double gaugeMatrix[6][6];  /*!< gauges to F/T matrix (MatrixFX ... MatrixTz), applied inside the box */
+    double gaugeGains[6];
+    double gaugeOffsets[6];
+
+    // tblCalibrationInformation
+    std::string forceUnits;
+    std::string torqueUnits;
+    double countsPerForce;
+    double countsPerTorque;
+    double maxRatings[6];
+};
+
+/**
+ * Parse a Net F/T calibration file.
+ * Mandatory entries are the six matrix rows, CountsPerForce and CountsPerTorque,
+ * every other entry is optional.
+ * @param[in] fileName path of the calibration file
+ * @param[out] calibration the parsed content
+ * @param[out] error human readable description of the problem if parsing fails
+ * @return true on success
+ */
+bool loadCalibrationFile(const std::string &fileName, NetFTCalibration &calibration, std::string &error);
+
+/**
+ * Precomputed 6x6 matrix mapping the RDT counts to the wrench in the output frame.
+ *
+ * It folds, in this order, the counts to force/torque units scaling, the optional user
+ * tool transform and the optional sensor to output frame rotation, so that converting a
+ * record costs a single fixed-size matrix-vector product.
+ */
+class WrenchTransform {
+public:
+    WrenchTransform();
+
+    /**
+     * Build the matrix.
+     * @param calibration parsed calibration file (for the counts per unit)
+     * @param toolTransform position (in the length unit of the calibration torque, e.g. m for N-m)
+     *        and orientation (roll, pitch, yaw in degrees) of the tool frame w.r.t. the sensor frame,
+     *        or NULL if no tool transform is used
+     * @param outputRotation row-major 3x3 rotation from the (tool) frame to the output frame,
+     *        or NULL if the output frame coincides with the (tool) frame
+     */
+    void build(const NetFTCalibration &calibration, const double *toolTransform, const double *outputRotation);
+
+    /**
+     * Read the optional toolTransform and sensorToOutputRotation parameters and build the matrix.
+     * @return false if one of the parameters is present but malformed
+     */
+    bool configure(const NetFTCalibration &calibration, yarp::os::Searchable &config, const std::string &logPrefix);
+
+    /**
+     * Convert a record
+     * @param[in] counts FTData of the RDT record
+     * @param[out] wrench forces and torques in the output frame
+     */
+    inline void apply(const int32_t counts[6], double wrench[6]) const
+    {
+        double c[6];
+        for (int j = 0; j < 6; ++j) {
+            c[j] = static_cast<double>(counts[j]);
+        }
+        for (int i = 0; i < 6; ++i) {
+            double value = 0.0;
+            for (int j = 0; j < 6; ++j) {
+                value += m_matrix[i][j] * c[j];
+            }
+            wrench[i] = value;
+        }
+    }
+
+    const double (&matrix() const)[6][6] { return m_matrix; }
+
+private:
+    double m_matrix[6][6];
+};
+
+}
+
+#endif
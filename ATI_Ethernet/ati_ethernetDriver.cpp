@@ -9,17 +9,95 @@
 #include <cassert>
 
 #include <yarp/math/Math.h>
+#include <yarp/os/Thread.h>
+#include <yarp/os/Time.h>
 
 #include <string>
 #include <sstream>
+#include <algorithm>
 
 #include <errno.h>
 
 using namespace yarp::math;
 
+namespace {
+
+#ifdef _WIN32
+    const SOCKET INVALID_HANDLE = INVALID_SOCKET;
+#else
+    const int INVALID_HANDLE = -1;
+#endif
+
+    int lastSocketError()
+    {
+#ifdef _WIN32
+        return WSAGetLastError();
+#else
+        return errno;
+#endif
+    }
+
+    bool isTimeoutError(int error)
+    {
+#ifdef _WIN32
+        return error == WSAETIMEDOUT;
+#else
+        return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+#endif
+    }
+
+    std::string socketErrorString(int error)
+    {
+        std::stringstream ss;
+#ifdef _WIN32
+        ss << "socket error " << error;
+#else
+        ss << strerror(error);
+#endif
+        return ss.str();
+    }
+}
+
+/**
+ * Thread receiving the RDT stream. It never blocks for more than the receive timeout,
+ * so it notices both silent sensors and stop requests.
+ */
+class yarp::dev::ati_ethernetDriver::ReaderThread : public yarp::os::Thread
+{
+    yarp::dev::ati_ethernetDriver &driver;
+
+public:
+    ReaderThread(yarp::dev::ati_ethernetDriver &_driver) : driver(_driver) {}
+
+    virtual void run()
+    {
+        while (!isStopping()) {
+            driver.readerStep();
+        }
+    }
+};
+
 yarp::dev::ati_ethernetDriver::ati_ethernetDriver(): m_sensorReadings(6),
                                                                  m_status(yarp::dev::IAnalogSensor::AS_OK),
-                                                                    cMatrix (6,6)
+                                                                 m_sampleFlags(ati_rdt::RDT_SAMPLE_OK),
+                                                                 m_diagnosticChannels(false),
+                                                                 socketHandle(INVALID_HANDLE),
+                                                                 m_reader(0),
+                                                                 m_connectionState(CONNECTION_CLOSED),
+                                                                 m_timeout(0.1),
+                                                                 m_minBackoff(0.1),
+                                                                 m_maxBackoff(5.0),
+                                                                 m_backoff(0.1),
+                                                                 m_lastRequestTime(0),
+                                                                 m_lastRecordTime(0),
+                                                                 m_outageStart(-1),
+                                                                 m_hardwareBias(true),
+                                                                 m_biasState(BIAS_IDLE),
+                                                                 m_biasSequence(0),
+                                                                 m_biasSettleRecords(16),
+                                                                 m_tareWindow(100),
+                                                                 m_ringHead(0),
+                                                                 m_ringCount(0)
 {
     yInfo("Constructor beggining.");
     // We fill the sensor readings only once in the constructor in this example
@@ -27,12 +105,20 @@ yarp::dev::ati_ethernetDriver::ati_ethernetDriver(): m_sensorReadings(6),
    m_sensorReadings[0] = 0;
     m_sensorReadings[1] = 0;
     m_sensorReadings[2] = 0;
-    
-    // Set torque on x,y,z axis 
+
+    // Set torque on x,y,z axis
     m_sensorReadings[3] = 0;
     m_sensorReadings[4] = 0;
     m_sensorReadings[5] = 0;
-    
+
+    memset(&resp, 0, sizeof(resp));
+    memset(&m_rdtStatistics, 0, sizeof(m_rdtStatistics));
+    memset(&m_downtime, 0, sizeof(m_downtime));
+    for (int i = 0; i < 6; ++i) {
+        m_tareChannels[i] = false;
+        m_tareTarget[i] = 0;
+        m_tareOffset[i] = 0;
+    }
 
     // When you update the sensor readings, you also need to update the timestamp
     m_timestamp.update();
@@ -41,6 +127,7 @@ yarp::dev::ati_ethernetDriver::ati_ethernetDriver(): m_sensorReadings(6),
 
 yarp::dev::ati_ethernetDriver::~ati_ethernetDriver()
 {
+    close();
 }
 
 bool yarp::dev::ati_ethernetDriver::open(yarp::os::Searchable &config)
@@ -49,106 +136,185 @@ bool yarp::dev::ati_ethernetDriver::open(yarp::os::Searchable &config)
 
 
     yDebug("Ati_ethernetDriver: opening");
-    std::lock_guard<std::mutex> guard(m_mutex);
+    std::unique_lock<std::mutex> guard(m_mutex);
+    if (m_reader) {
+        yError("Ati_ethernetDriver: device already opened");
+        return false;
+    }
 
     // config should be parsed for the options of the device
     std::string sensorname;
     sensorname=config.findGroup("calibrationFile").tail().get(0).toString();
     yInfo()<<"Ati_ethernetDriver: calibration file name"<<sensorname;
 
+    m_diagnosticChannels = config.check("diagnosticChannels", yarp::os::Value(false), "append flags, status, ft_sequence and lost records to the wrench").asBool();
+    uint32_t errorMask = config.check("statusErrorMask", yarp::os::Value(static_cast<int>(ati_rdt::RDT_STATUS_DEFAULT_ERROR_MASK)), "status word bits mapped to AS_ERROR").asInt32();
+    uint32_t overflowMask = config.check("statusOverflowMask", yarp::os::Value(static_cast<int>(ati_rdt::RDT_STATUS_DEFAULT_OVERFLOW_MASK)), "status word bits mapped to AS_OVF").asInt32();
+    m_sequenceTracker.reset();
+    m_sequenceTracker.setStatusMasks(errorMask, overflowMask);
+
+    m_timeout = config.check("timeout", yarp::os::Value(0.1), "seconds without records before timeout error (s)").asFloat64();
+    m_minBackoff = config.check("reconnectMinDelay", yarp::os::Value(0.1), "first delay before re-issuing the streaming request (s)").asFloat64();
+    m_maxBackoff = config.check("reconnectMaxDelay", yarp::os::Value(5.0), "maximum delay between two streaming requests (s)").asFloat64();
+    if (m_timeout <= 0 || m_minBackoff <= 0 || m_maxBackoff < m_minBackoff) {
+        yError("Ati_ethernetDriver: timeout and reconnect delays must be positive, with reconnectMaxDelay >= reconnectMinDelay");
+        return false;
+    }
+    m_backoff = m_minBackoff;
+
+    std::string biasMode = config.check("biasMode", yarp::os::Value("hardware"), "calibrateSensor() implementation (hardware|software)").asString();
+    if (biasMode != "hardware" && biasMode != "software") {
+        yError("Ati_ethernetDriver: biasMode option not recognized. Only (hardware|software) are allowed");
+        return false;
+    }
+    m_hardwareBias = biasMode == "hardware";
+    int tareWindow = config.check("tareWindow", yarp::os::Value(100), "records averaged by the software tare").asInt32();
+    if (tareWindow <= 0) {
+        yError("Ati_ethernetDriver: tareWindow must be positive");
+        return false;
+    }
+    m_tareWindow = static_cast<unsigned>(tareWindow);
+    int biasSettleRecords = config.check("biasSettleRecords", yarp::os::Value(16), "records after the bias command still considered unbiased (in flight)").asInt32();
+    if (biasSettleRecords < 0) {
+        yError("Ati_ethernetDriver: biasSettleRecords must not be negative");
+        return false;
+    }
+    m_biasSettleRecords = static_cast<unsigned>(biasSettleRecords);
+    m_wrenchRing.assign(6 * m_tareWindow, 0.0);
+    m_ringHead = 0;
+    m_ringCount = 0;
+    m_biasState = BIAS_IDLE;
+
+     std::string error;
+     if (!ati_rdt::loadCalibrationFile(sensorname, m_calibration, error))
+     {
+         yError()<<"Ati_ethernetDriver: invalid calibration file:"<<error;
+         return false;
+     }
+     yInfo()<<"Ati_ethernetDriver: loaded calibration"<<m_calibration.calibrationPartNumber<<"of sensor"<<m_calibration.serialNumber
+            <<"- CountsPerForce"<<m_calibration.countsPerForce<<"CountsPerTorque"<<m_calibration.countsPerTorque;
+
+     if (!m_wrenchTransform.configure(m_calibration, config, "Ati_ethernetDriver:"))
+     {
+         return false;
+     }
 
     #ifdef _WIN32
 	wVersionRequested = MAKEWORD(2, 2);
     WSAStartup(wVersionRequested, &wsaData);
 #endif
 
-	/* Calculate number of samples, command code, and open socket here. */
-	socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-	if (socketHandle == -1) {
-        yError("Ati_ethernetDriver: Socket could not be opened.\n");
-		exit(1);
-	}
-*(uint16_t*)&request[0] = htons(0x1234); /* standard header. */
-    *(uint16_t*)&request[2] = htons(COMMAND); /* per table 9.1 in Net F/T user manual. */
-    *(uint32_t*)&request[4] = htonl(1); /* see section 9.1 in Net F/T user manual. */
-	
-    yInfo("Ati_ethernetDriver: Sending the request.");
-
-    he = gethostbyname(config.findGroup("ipAddress").tail().get(0).asString().c_str());// TODO: get ipAddres from config file
-
-    if( he == 0 )
+    std::string ipAddress = config.findGroup("ipAddress").tail().get(0).asString();
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo *address = 0;
+    if (getaddrinfo(ipAddress.c_str(), 0, &hints, &address) != 0 || !address)
     {
-        yError("Ati_ethernetDriver: Error in calling gethostbyname");
+        yError()<<"Ati_ethernetDriver: could not resolve"<<ipAddress;
+#ifdef _WIN32
+        WSACleanup();
+#endif
         return false;
     }
-
-        yDebug("Ati_ethernetDriver: reading ip address");
-    memcpy(&addr.sin_addr,
-           he->h_addr_list[0],
-           he->h_length);
+    memcpy(&addr, address->ai_addr, sizeof(addr));
+    freeaddrinfo(address);
 	addr.sin_family = AF_INET;
 	addr.sin_port = htons(PORT);
-     yDebug("Ati_ethernetDriver: Attempting connection");
-     err = connect( socketHandle, (struct sockaddr *)&addr, sizeof(addr) );
-     if (err == -1) {
-         yError("Ati_ethernetDriver: Socket could not conect.\n");
-         exit(2);
-     }
 
+    // The first connection is attempted here so that configuration errors are reported by open().
+    // Later failures are handled by the reader thread.
+    if (!openSocket()) {
+        closeSocket();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+    double now = yarp::os::Time::now();
+    m_lastRecordTime = now;
+    m_outageStart = -1;
+    m_status = yarp::dev::IAnalogSensor::AS_TIMEOUT; // until the first record arrives
+    guard.unlock();
+    sendStreamingRequest();
+
+    m_reader = new ReaderThread(*this);
+    if (!m_reader->start()) {
+        yError("Ati_ethernetDriver: failed to start the reader thread");
+        delete m_reader;
+        m_reader = 0;
+        closeSocket();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+    return true;
+}
 
-     TiXmlDocument calibFile( sensorname );
-     bool loaded= calibFile.LoadFile();
-     if (loaded)
-     {
-         yDebug("Ati_ethernetDriver: Opened file Correctly");
-
-//         yInfo(  calibFile.FirstChild( "dsNetFTCalibrationFile" )->FirstChild("tblNetFTCalibrationInfo")->FirstChild("MatrixFX")->FirstChild()->Value());
-//         const char *AXES[] = { "FX", "Fy", "Fz", "Tx", "Ty", "Tz" };	/* The names of the force and torque axes. */
-//         std::vector<std::string> axes(AXES, AXES + 6);
-//         for(int i=0;i<6;++i)
-//         {
-//             std::string temp=calibFile.FirstChild( "dsNetFTCalibrationFile" )->FirstChild("tblNetFTCalibrationInfo")->FirstChild("Matrix"+axes[i])->FirstChild()->Value();
-//             yarp::sig::Vector tempVector(6);
-//             vector6FromString(temp, tempVector);
-//             bool inserted=cMatrix.setRow(i,tempVector);
-//             if(inserted){
-//                 std::stringstream ss;
-//                 ss << "length of row "<< i << " in matrix is "<<cMatrix.getRow(i)[1];
-//                 std::string str = ss.str();
-//                 yInfo(str);
-
-//                 ss << tempVector[0];
-//                 str = ss.str();
-//                 yInfo("position 0 in tempVector is "+ str);
-//             }
-//             else{
-//                 yError("Ati_ethernetDriver: Couldnt insert vector to calibration matrix");
-//             }
-
-//         }
-
-        // yInfo(  calibFile.FirstChild( "dsNetFTCalibrationFile" )->FirstChild( "tblCalibrationInformation" )->FirstChild("CountsPerForce")->FirstChild()->Value());
-         std::string temp=calibFile.FirstChild( "dsNetFTCalibrationFile" )->FirstChild( "tblCalibrationInformation" )->FirstChild("CountsPerForce")->FirstChild()->Value();
-         stringToDouble( temp,countsperForce);
-         yInfo()<<"CountsPerForce value read:"<<temp;
-        // yInfo( calibFile.FirstChild( "dsNetFTCalibrationFile" )->FirstChild( "tblCalibrationInformation" )->FirstChild("CountsPerTorque")->FirstChild()->Value());
-         temp=calibFile.FirstChild( "dsNetFTCalibrationFile" )->FirstChild( "tblCalibrationInformation" )->FirstChild("CountsPerTorque")->FirstChild()->Value();
-         stringToDouble( temp,countsperTorque);
-          yInfo()<<"CountsPerTorque value read:"<<temp;
-     }
-     else
-     {
-         yError("Ati_ethernetDriver: Could not load file");
-     }
+bool yarp::dev::ati_ethernetDriver::close()
+{
+    if (m_reader) {
+        m_reader->stop();
+        delete m_reader;
+        m_reader = 0;
+
+        if (socketHandle != INVALID_HANDLE) {
+            unsigned char request[ati_rdt::RDT_REQUEST_SIZE];
+            ati_rdt::encodeRequest(ati_rdt::RDT_COMMAND_STOP_STREAMING, 0, request);
+            send(socketHandle, (const char *)request, sizeof(request), 0);
+        }
+        closeSocket();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_status = yarp::dev::IAnalogSensor::AS_ERROR;
+    return true;
+}
 
+yarp::dev::ati_ethernetDriver::ati_ethernetDriver(const yarp::dev::ati_ethernetDriver& /*other*/)
+{
+    // Copy is disabled
+    assert(false);
+}
 
+bool yarp::dev::ati_ethernetDriver::openSocket()
+{
+	socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (socketHandle == INVALID_HANDLE) {
+        yError()<<"Ati_ethernetDriver: Socket could not be opened:"<<socketErrorString(lastSocketError());
+        return false;
+	}
+
+    // Bounded receive: the reader thread must notice silent sensors and stop requests
+#ifdef _WIN32
+    DWORD receiveTimeout = static_cast<DWORD>(m_timeout * 1000.0);
+#else
+    struct timeval receiveTimeout;
+    receiveTimeout.tv_sec = static_cast<long>(m_timeout);
+    receiveTimeout.tv_usec = static_cast<long>((m_timeout - receiveTimeout.tv_sec) * 1e6);
+#endif
+    if (setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, (const char *)&receiveTimeout, sizeof(receiveTimeout)) < 0) {
+        yError()<<"Ati_ethernetDriver: could not set the receive timeout:"<<socketErrorString(lastSocketError());
+        return false;
+    }
 
-     return true;
+    if (connect(socketHandle, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        yError()<<"Ati_ethernetDriver: Socket could not conect:"<<socketErrorString(lastSocketError());
+        return false;
+    }
+    m_connectionState = CONNECTION_REQUESTED;
+    return true;
 }
 
-bool yarp::dev::ati_ethernetDriver::close()
+void yarp::dev::ati_ethernetDriver::closeSocket()
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
+    if (socketHandle == INVALID_HANDLE) {
+        return;
+    }
 #ifdef _WIN32
     closesocket(socketHandle);
 #else
@@ -157,136 +323,338 @@ bool yarp::dev::ati_ethernetDriver::close()
        yError("Ati_ethernetDriver: Could not close properly"); ;
         }
 #endif
+    socketHandle = INVALID_HANDLE;
+    m_connectionState = CONNECTION_CLOSED;
+}
+
+bool yarp::dev::ati_ethernetDriver::sendStreamingRequest()
+{
+    m_lastRequestTime = yarp::os::Time::now();
+    unsigned char request[ati_rdt::RDT_REQUEST_SIZE];
+    ati_rdt::encodeRequest(ati_rdt::RDT_COMMAND_START_HIGH_SPEED_STREAMING, ati_rdt::RDT_INFINITE_SAMPLES, request);
+    if (send(socketHandle, (const char *)request, sizeof(request), 0) < 0) {
+        yError()<<"Ati_ethernetDriver: failed to send the streaming request:"<<socketErrorString(lastSocketError());
+        return false;
+    }
+    // Every request starts a new RDT stream on the Net F/T
+    m_sequenceTracker.startStream();
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_downtime.requests++;
     return true;
 }
 
-yarp::dev::ati_ethernetDriver::ati_ethernetDriver(const yarp::dev::ati_ethernetDriver& /*other*/)
+void yarp::dev::ati_ethernetDriver::beginOutage(double now, int status)
 {
-    // Copy is disabled
-    assert(false);
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_status = status;
+    if (m_outageStart >= 0) {
+        return;
+    }
+    // The outage started when the last record was received
+    m_outageStart = m_lastRecordTime;
+    m_downtime.outages++;
+    m_downtime.lastOutageStart = m_outageStart;
+    yWarning()<<"Ati_ethernetDriver: no records since"<<now - m_lastRecordTime<<"s, reconnecting";
 }
 
-int yarp::dev::ati_ethernetDriver::read(yarp::sig::Vector &out)
+void yarp::dev::ati_ethernetDriver::endOutage(double now)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    yDebug("Sending request");
-   // send( socketHandle, (const char *)request, 8, 0 );
-    int s=0;
-    if ((s= send( socketHandle, (const char *)request, 8, 0 )) < 0) {
-        int errsv = errno;
-
-                   yError("Ati_ethernetDriver:Read:Failed to send bytes from server");
-
-                       std::stringstream ss;
-                          ss <<strerror(errsv);
-                        std::string str = ss.str();
-                         yError()<<str;
-
-                   exit(1);
-                 }
-      yDebug()<<"recieved value of send function= "<<s;
-    /* Receiving the response. */
-        int r=0;
-        yDebug()<<"r to 0 next comand recv";
-   // recv( socketHandle, (char *)response, 36, 0 );
-    if ((r = recv( socketHandle, (char *)response, 36, 0 )) < 1) {
-        int errsv = errno;
-
-                   yError("Ati_ethernetDriver:Read:Failed to receive bytes from server");
-                   if(r==0){
-                       yError("Ati_ethernetDriver:Read: 0 bytes received");
-
-                   }
-                   else
-                   {
-                       std::stringstream ss;
-                          ss <<strerror(errsv);
-                        std::string str = ss.str();
-                         yError()<<str;
-                   }
-                   exit(1);
-                 }
-    else{
-        std::stringstream ss;
-           ss <<"recieved value of recv function= "<<r;
-         std::string str = ss.str();
-          yDebug()<<str;
-    resp.rdt_sequence = ntohl(*(uint32_t*)&response[0]);
-    resp.ft_sequence = ntohl(*(uint32_t*)&response[4]);
-    resp.status = ntohl(*(uint32_t*)&response[8]);
-    for( i = 0; i < 6; ++i ) {
-        resp.FTData[i] = ntohl(*(int*)&response[12 + i * 4]);
-	}
+    if (m_outageStart < 0) {
+        return;
     }
-    // Set force and torque measurements on x,y,z axis
-    
-    for (i =0;i < 6;++i) {
-//        double m_temp=0; // aparently raw measurements are already given in counts which dont require the calibration matrix
-//        for(int j =0;j < 6;++j){
-//            std::stringstream ss;
-//            ss <<" m_temp previous summation "<< m_temp;
-//            m_temp=m_temp + ((double)resp.FTData[j])*cMatrix(i,j);
-
-//            ss << " raw measurement  "<< resp.FTData[j] << " matrix row "<<i<<" column "<<j <<" value "<<cMatrix(i,j)<<" temp measuremnet "<<m_temp<< "\n";
-//            std::string str = ss.str();
-//            yInfo(str);
-//        }
-//        m_sensorReadings[i]=m_temp;
-        if(i<3)
-        m_sensorReadings[i]=((double)resp.FTData[i])/countsperForce;
-        else
-        m_sensorReadings[i]=((double)resp.FTData[i])/countsperTorque;
+    double duration = now - m_outageStart;
+    m_downtime.totalDowntime += duration;
+    m_downtime.longestDowntime = std::max(m_downtime.longestDowntime, duration);
+    m_outageStart = -1;
+    yInfo()<<"Ati_ethernetDriver: stream recovered after"<<duration<<"s";
+}
+
+void yarp::dev::ati_ethernetDriver::publishRecord(const RESPONSE &record, int flags, double now)
+{
+    double wrench[6];
+    m_wrenchTransform.apply(record.FTData, wrench);
+
+    int status = yarp::dev::IAnalogSensor::AS_OK;
+    if (flags & ati_rdt::RDT_SAMPLE_STATUS_ERROR) {
+        status = yarp::dev::IAnalogSensor::AS_ERROR;
     }
+    else if (flags & ati_rdt::RDT_SAMPLE_STATUS_OVERFLOW) {
+        status = yarp::dev::IAnalogSensor::AS_OVF;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
 
+    // The records in flight when the bias command has been sent are not biased yet: the bias is complete
+    // once m_biasSettleRecords records have followed them, or when a new stream has been started
+    if (m_biasState == BIAS_HARDWARE_SENT
+        && (record.rdt_sequence < m_biasSequence || record.rdt_sequence - m_biasSequence > m_biasSettleRecords)) {
+        // The software offsets and the records received before the bias,
+        // which a software tare would average, are obsolete
+        for (int i = 0; i < 6; ++i) m_tareOffset[i] = 0;
+        m_ringHead = 0;
+        m_ringCount = 0;
+        m_biasState = BIAS_IDLE;
+        yInfo("Ati_ethernetDriver: hardware bias completed");
+    }
+
+    // Keep the untared wrench for the software tare
+    std::copy(wrench, wrench + 6, m_wrenchRing.begin() + 6 * m_ringHead);
+    m_ringHead = (m_ringHead + 1) % m_tareWindow;
+    if (m_ringCount < m_tareWindow) {
+        m_ringCount++;
+    }
+
+    if (m_biasState == BIAS_SOFTWARE_PENDING && m_ringCount == m_tareWindow) {
+        applySoftwareTare();
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        m_sensorReadings[i] = wrench[i] - m_tareOffset[i];
+    }
+    resp = record;
+    m_sampleFlags = flags;
+    m_rdtStatistics = m_sequenceTracker.statistics();
+    m_status = status;
     // When you update the sensor readings, you also need to update the timestamp
-    m_timestamp.update();
+    m_timestamp.update(now);
+}
+
+void yarp::dev::ati_ethernetDriver::sendBiasCommand()
+{
+    unsigned char request[ati_rdt::RDT_REQUEST_SIZE];
+    ati_rdt::encodeRequest(ati_rdt::RDT_COMMAND_SET_SOFTWARE_BIAS, 0, request);
+    // The bias command does not interrupt the stream: it can be sent on the streaming socket
+    bool sent = send(socketHandle, (const char *)request, sizeof(request), 0) >= 0;
+    if (!sent) {
+        yError()<<"Ati_ethernetDriver: failed to send the bias command:"<<socketErrorString(lastSocketError());
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (sent && m_biasState == BIAS_HARDWARE_REQUESTED) {
+        m_biasState = BIAS_HARDWARE_SENT;
+        m_biasSequence = resp.rdt_sequence;
+    }
+}
+
+void yarp::dev::ati_ethernetDriver::applySoftwareTare()
+{
+    // Called with m_mutex locked, once the ring contains m_tareWindow records
+    for (int i = 0; i < 6; ++i) {
+        if (!m_tareChannels[i]) {
+            continue;
+        }
+        double mean = 0.0;
+        for (size_t j = 0; j < m_ringCount; ++j) {
+            mean += m_wrenchRing[6 * j + i];
+        }
+        mean /= m_ringCount;
+        m_tareOffset[i] = mean - m_tareTarget[i];
+    }
+    m_biasState = BIAS_IDLE;
+    yInfo("Ati_ethernetDriver: software tare completed on %u records", m_tareWindow);
+}
+
+int yarp::dev::ati_ethernetDriver::requestBias(int channel, const double *target)
+{
+    // Called with m_mutex locked
+    if (channel >= 6) {
+        return yarp::dev::IAnalogSensor::AS_ERROR;
+    }
+    if (m_hardwareBias && channel < 0 && !target) {
+        // The reader thread owns the socket: it will send the command at its next iteration
+        m_biasState = BIAS_HARDWARE_REQUESTED;
+        return yarp::dev::IAnalogSensor::AS_OK;
+    }
+
+    // Software tare, also used when a channel or a target value is specified,
+    // as the RDT bias command only zeroes all the channels
+    for (int i = 0; i < 6; ++i) {
+        bool selected = channel < 0 || channel == i;
+        if (m_biasState != BIAS_SOFTWARE_PENDING) {
+            m_tareChannels[i] = false;
+        }
+        if (selected) {
+            m_tareChannels[i] = true;
+            m_tareTarget[i] = target ? target[channel < 0 ? i : 0] : 0.0;
+        }
+    }
+    m_biasState = BIAS_SOFTWARE_PENDING;
+    if (m_ringCount == m_tareWindow) {
+        // Enough records already received: the tare is completed immediately
+        applySoftwareTare();
+    }
+    return yarp::dev::IAnalogSensor::AS_OK;
+}
+
+void yarp::dev::ati_ethernetDriver::readerStep()
+{
+    double now = yarp::os::Time::now();
+
+    if (m_connectionState == CONNECTION_CLOSED) {
+        // Reopen the socket once the backoff has elapsed
+        if (now - m_lastRequestTime < m_backoff) {
+            yarp::os::Time::delay(std::min(m_timeout, m_backoff - (now - m_lastRequestTime)));
+            return;
+        }
+        m_backoff = std::min(2 * m_backoff, m_maxBackoff);
+        if (!openSocket()) {
+            closeSocket();
+            m_lastRequestTime = now;
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_downtime.reconnections++;
+        }
+        if (!sendStreamingRequest()) {
+            closeSocket();
+        }
+        return;
+    }
+
+    bool biasRequested;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        biasRequested = m_biasState == BIAS_HARDWARE_REQUESTED;
+    }
+    if (biasRequested) {
+        sendBiasCommand();
+    }
+
+    unsigned char datagram[ati_rdt::RDT_RECORD_SIZE];
+    int received = recv(socketHandle, (char *)datagram, sizeof(datagram), 0);
+    now = yarp::os::Time::now();
+
+    if (received < 0) {
+        int error = lastSocketError();
+        if (!isTimeoutError(error)) {
+            // e.g. ICMP port unreachable while the box reboots: start over with a new socket
+            yError()<<"Ati_ethernetDriver: failed to receive:"<<socketErrorString(error);
+            {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                m_downtime.socketErrors++;
+            }
+            beginOutage(now, yarp::dev::IAnalogSensor::AS_ERROR);
+            closeSocket();
+            m_lastRequestTime = now;
+            return;
+        }
+    }
+    else {
+        RESPONSE record;
+        int flags = ati_rdt::RDT_SAMPLE_OK;
+        if (!ati_rdt::decodeRecord(datagram, received, record)) {
+            yError()<<"Ati_ethernetDriver: short RDT record of"<<received<<"bytes";
+        }
+        else if (m_sequenceTracker.update(record, flags)) {
+            publishRecord(record, flags, now);
+            m_lastRecordTime = now;
+            m_connectionState = CONNECTION_STREAMING;
+            m_backoff = m_minBackoff;
+            endOutage(now);
+            return;
+        }
+    }
+
+    // No fresh record: check for a silent sensor
+    if (now - m_lastRecordTime > m_timeout) {
+        beginOutage(now, yarp::dev::IAnalogSensor::AS_TIMEOUT);
+        if (now - m_lastRequestTime >= m_backoff) {
+            m_connectionState = CONNECTION_REQUESTED;
+            m_backoff = std::min(2 * m_backoff, m_maxBackoff);
+            if (!sendStreamingRequest()) {
+                closeSocket();
+            }
+        }
+    }
+}
+
+int yarp::dev::ati_ethernetDriver::read(yarp::sig::Vector &out)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
     out = m_sensorReadings;
-    
+    if (m_diagnosticChannels) {
+        out.resize(10);
+        out[6] = m_sampleFlags;
+        out[7] = resp.status;
+        out[8] = resp.ft_sequence;
+        out[9] = static_cast<double>(m_rdtStatistics.lostRecords);
+    }
+
     return m_status;
 }
 
 int yarp::dev::ati_ethernetDriver::getState(int /*ch*/)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-        yDebug("checking state");
+    // A bias in progress is reported as a timeout, as the readings are not yet zeroed
+    if (m_biasState != BIAS_IDLE && m_status == yarp::dev::IAnalogSensor::AS_OK) {
+        return yarp::dev::IAnalogSensor::AS_TIMEOUT;
+    }
     return m_status;
 }
 
 int yarp::dev::ati_ethernetDriver::getChannels()
 {
-    return 6;
+    return m_diagnosticChannels ? 10 : 6;
 }
 
 int yarp::dev::ati_ethernetDriver::calibrateSensor()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    //read sensorSheet file? or zeroing?
-    return m_status;
+    return requestBias(-1, 0);
 }
 
-int yarp::dev::ati_ethernetDriver::calibrateSensor(const yarp::sig::Vector& /*value*/)
+int yarp::dev::ati_ethernetDriver::calibrateSensor(const yarp::sig::Vector& value)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    
-    return m_status;
+    if (value.size() != 6) {
+        yError("Ati_ethernetDriver: calibrateSensor expects 6 values");
+        return yarp::dev::IAnalogSensor::AS_ERROR;
+    }
+    return requestBias(-1, value.data());
 }
 
-int yarp::dev::ati_ethernetDriver::calibrateChannel(int /*ch*/)
+int yarp::dev::ati_ethernetDriver::calibrateChannel(int ch)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    
-    return m_status;
+    double zero = 0.0;
+    return ch < 0 ? yarp::dev::IAnalogSensor::AS_ERROR : requestBias(ch, &zero);
 }
 
-int yarp::dev::ati_ethernetDriver::calibrateChannel(int /*ch*/, double /*v*/)
+int yarp::dev::ati_ethernetDriver::calibrateChannel(int ch, double v)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    
-    return m_status;
+    return ch < 0 ? yarp::dev::IAnalogSensor::AS_ERROR : requestBias(ch, &v);
 }
 
 yarp::os::Stamp yarp::dev::ati_ethernetDriver::getLastInputStamp()
 {
+    std::lock_guard<std::mutex> guard(m_mutex);
     return m_timestamp;
 }
 
+void yarp::dev::ati_ethernetDriver::getRDTStatistics(ati_rdt::RDTStatistics &stats)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    stats = m_rdtStatistics;
+}
+
+int yarp::dev::ati_ethernetDriver::getLastSampleFlags()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_sampleFlags;
+}
+
+void yarp::dev::ati_ethernetDriver::getDowntimeStatistics(DowntimeStatistics &stats)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    stats = m_downtime;
+    if (m_outageStart >= 0) {
+        // account the outage in progress
+        double current = yarp::os::Time::now() - m_outageStart;
+        stats.totalDowntime += current;
+        stats.longestDowntime = std::max(stats.longestDowntime, current);
+    }
+}
@@ -15,10 +15,10 @@
 #include <yarp/dev/IPreciselyTimed.h>
 
 #include <yarp/sig/Vector.h>
-#include <yarp/sig/Matrix.h>
 
 #include <iostream>
 #include <mutex>
+#include <vector>
 
 #ifdef _WIN32
 	#include <winsock2.h>
@@ -36,21 +36,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
- #include <vector>
+#include "ati_rdtProtocol.h"
+#include "ati_calibration.h"
 
-#include <tinyxml.h>
+#define PORT ati_rdt::RDT_PORT /* Port the Net F/T always uses */
 
-#define PORT 49152 /* Port the Net F/T always uses */
-#define COMMAND 2 /* Command code 2 starts streaming */
-
-typedef unsigned char byte;
 /* Typedefs used so integer sizes are more explicit */
-typedef struct response_struct {
-    uint32_t rdt_sequence;
-    uint32_t ft_sequence;
-    uint32_t status;
-    int FTData[6];
-} RESPONSE;
+typedef ati_rdt::RDTRecord RESPONSE;
 
 namespace sys{namespace socket{}}
 namespace yarp {
@@ -75,10 +67,24 @@ private:
     // Status of the sensor 
     int m_status;
 
-    // Calibration matrix
-    yarp::sig::Matrix cMatrix;
-    double countsperForce;
-    double countsperTorque;
+    // Sequence and status word tracking of the RDT records
+    ati_rdt::RDTSequenceTracker m_sequenceTracker; /*!< only accessed by the reader thread once opened */
+    ati_rdt::RDTStatistics m_rdtStatistics; /*!< copy of the tracker counters published with the last sample */
+    int m_sampleFlags; /*!< combination of ati_rdt::RDTSampleFlags of the last published sample */
+    bool m_diagnosticChannels; /*!< if true read() appends flags, status, ft_sequence and lost records to the wrench */
+
+    // Calibration file content and precomputed counts to output wrench matrix
+    ati_rdt::NetFTCalibration m_calibration;
+    ati_rdt::WrenchTransform m_wrenchTransform;
+
+    /**
+     * State of the connection with the Net F/T, owned by the reader thread
+     */
+    enum ConnectionState {
+        CONNECTION_CLOSED,    /*!< no socket: (re)open it after the backoff */
+        CONNECTION_REQUESTED, /*!< streaming request sent, waiting for the first record */
+        CONNECTION_STREAMING  /*!< records are arriving */
+    };
 
     //Variables used in the original exmample
 #ifdef _WIN32
@@ -89,82 +95,70 @@ private:
 	int socketHandle;			/* Handle to UDP socket used to communicate with Net F/T. */
 #endif
 	struct sockaddr_in addr;	/* Address of Net F/T. */
-	struct hostent *he;			/* Host entry for Net F/T. */
-	byte request[8];			/* The request data sent to the Net F/T. */
 	RESPONSE resp;				/* The structured response received from the Net F/T. */
-	byte response[36];			/* The raw response data received from the Net F/T. */
-	int i;						/* Generic loop/array index. */
-	int err;					/* Error status of operations. */
-
-    bool inline stringToDouble(const std::string & inStr, double & outDouble)
-        {
-           outDouble = std::atof(inStr.c_str());
-            return true;
-        }
-
-
-    std::string inline intToString(const int inInt)
-        {
-            std::stringstream ss;
-            ss << inInt;
-            return ss.str();
-        }
-
-    bool inline splitString(const std::string & inStr, std::vector<std::string> & pieces)
-        {
-            std::istringstream iss(inStr);
-            pieces.resize(0);
-            do
-            {
-                std::string sub;
-                iss >> sub;
-                if( sub != "" )
-               {
-                    pieces.push_back(sub);
-                }
-           } while (iss);
-             return true;
-        }
-
-    bool inline vector6FromString(const std::string & vector_str, yarp::sig::Vector & out)
-      {
-           std::vector<std::string> pieces;
-           std::vector<double> xyz;
-           splitString(vector_str,pieces);
-           for (unsigned int i = 0; i < pieces.size(); ++i)
-           {
-             if (pieces[i] != ""){
-              double newDouble;
-              if( stringToDouble(pieces[i],newDouble) )
-              {
-                 xyz.push_back(newDouble);
-                 yDebug()<<"vector6FromString: inserting double value"<<pieces[i];
-              }
-              else
-            {
-                  std::string errStr = "Unable to parse component [" + pieces[i] + "] to a double (while parsing a vector value)";
-                  yError()<<"vector6FromString:"<<errStr.c_str();
-                  return false;
-              }
-             }
-           }
-
-           if (xyz.size() != 6)
-           {
-               std::string errStr = "Parser found " + intToString(xyz.size())  + " elements but 6 expected while parsing vector [" + vector_str + "]";
-              yError()<<"vector6FromString:"<<errStr.c_str();
-              return false;
-          }
-
-          out[0]  = xyz[0];
-          out[1] = xyz[1];
-          out[2] = xyz[2];
-          out[3]  = xyz[3];
-          out[4] = xyz[4];
-          out[5] = xyz[5];
-
-          return true;
-      }
+
+    // Reader thread and connection handling
+    class ReaderThread;
+    ReaderThread *m_reader;          /*!< internal thread which receives the RDT stream */
+    ConnectionState m_connectionState;
+    double m_timeout;                /*!< seconds without records before AS_TIMEOUT */
+    double m_minBackoff;             /*!< first delay before re-issuing a request or reopening the socket */
+    double m_maxBackoff;             /*!< upper bound of the exponential backoff */
+    double m_backoff;                /*!< current backoff, only accessed by the reader thread */
+    double m_lastRequestTime;        /*!< only accessed by the reader thread */
+    double m_lastRecordTime;         /*!< only accessed by the reader thread */
+    double m_outageStart;            /*!< start of the current outage, negative if none */
+
+public:
+    /**
+     * Metrics about the periods in which no record was received
+     */
+    struct DowntimeStatistics {
+        unsigned long outages;         /*!< number of times the stream stopped for more than the timeout */
+        double totalDowntime;          /*!< seconds spent without records, including the current outage */
+        double longestDowntime;        /*!< longest outage (s) */
+        double lastOutageStart;        /*!< time at which the last outage started, 0 if none */
+        unsigned long requests;        /*!< streaming requests sent */
+        unsigned long reconnections;   /*!< times the socket has been reopened after an error */
+        unsigned long socketErrors;    /*!< send/recv errors other than timeouts */
+    };
+
+private:
+    DowntimeStatistics m_downtime; /*!< protected by m_mutex */
+
+    /**
+     * Progress of the last calibrateSensor()/calibrateChannel() request
+     */
+    enum BiasState {
+        BIAS_IDLE,                 /*!< no bias in progress */
+        BIAS_HARDWARE_REQUESTED,   /*!< the reader thread has to send the RDT bias command */
+        BIAS_HARDWARE_SENT,        /*!< bias command sent, waiting for the records sent after it */
+        BIAS_SOFTWARE_PENDING      /*!< waiting for the ring to contain a full tare window */
+    };
+
+    // Bias/tare, protected by m_mutex
+    bool m_hardwareBias;             /*!< true to use the RDT bias command, false for the software tare */
+    BiasState m_biasState;
+    uint32_t m_biasSequence;         /*!< rdt_sequence of the last record received before the bias command */
+    unsigned m_biasSettleRecords;    /*!< records following m_biasSequence which may have been sent before the bias */
+    unsigned m_tareWindow;           /*!< number of records averaged by the software tare */
+    std::vector<double> m_wrenchRing; /*!< last m_tareWindow wrenches before the software tare, 6 values each */
+    size_t m_ringHead;               /*!< next record to be written in m_wrenchRing */
+    size_t m_ringCount;              /*!< valid records in m_wrenchRing */
+    bool m_tareChannels[6];          /*!< channels affected by the pending software tare */
+    double m_tareTarget[6];          /*!< value the tared channels should read after the tare */
+    double m_tareOffset[6];          /*!< offset subtracted from the wrench by the software tare */
+
+    bool openSocket();
+    void closeSocket();
+    bool sendStreamingRequest();
+    void readerStep();
+    void publishRecord(const RESPONSE &record, int flags, double now);
+    void beginOutage(double now, int status);
+    void endOutage(double now);
+    void sendBiasCommand();
+    void applySoftwareTare();
+    int requestBias(int channel, const double *target);
 
 public:
     ati_ethernetDriver();
@@ -185,6 +179,24 @@ public:
     
     // IPreciselyTimed interface
     virtual yarp::os::Stamp getLastInputStamp();
+
+    /**
+     * Get the counters of received, lost, reordered and flagged RDT records
+     * @param[out] stats the current counters
+     */
+    void getRDTStatistics(ati_rdt::RDTStatistics &stats);
+
+    /**
+     * Get the flags of the last published sample
+     * @return combination of ati_rdt::RDTSampleFlags
+     */
+    int getLastSampleFlags();
+
+    /**
+     * Get the outage and reconnection counters
+     * @param[out] stats the current counters
+     */
+    void getDowntimeStatistics(DowntimeStatistics &stats);
 };
 
 }
@@ -0,0 +1,429 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#include "ati_netftManager.h"
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Thread.h>
+#include <yarp/os/Time.h>
+#include <yarp/os/Bottle.h>
+#include <yarp/dev/IAnalogSensor.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <unistd.h>
+
+/**
+ * Single thread serving all the sensors: it waits on an epoll set containing the socket of every
+ * sensor plus an eventfd used to wake it up on stop.
+ */
+class yarp::dev::ati_netftManager::NetFTReaderThread : public yarp::os::Thread
+{
+    yarp::dev::ati_netftManager &manager;
+    int epollHandle;
+    int stopEvent;
+
+    static const uint32_t STOP_EVENT_ID = 0xFFFFFFFFu; /*!< epoll id of the eventfd, sensors use their index */
+
+    /* Read every pending datagram of the sensor, publish the newest accepted one */
+    void drain(NetFTConnection &sensor, double arrivalTime)
+    {
+        unsigned char datagram[ati_rdt::RDT_RECORD_SIZE];
+        ati_rdt::RDTRecord record;
+        ati_rdt::RDTRecord latest;
+        int latestFlags = ati_rdt::RDT_SAMPLE_OK;
+        int flags = ati_rdt::RDT_SAMPLE_OK;
+        bool accepted = false;
+
+        while (true) {
+            ssize_t size = recv(sensor.socketHandle, datagram, sizeof(datagram), MSG_DONTWAIT);
+            if (size < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    yError() << "ati_netftManager: sensor" << sensor.sensorID << "failed to receive:" << strerror(errno);
+                }
+                break;
+            }
+            if (!ati_rdt::decodeRecord(datagram, size, record)) {
+                yError() << "ati_netftManager: sensor" << sensor.sensorID << "short RDT record of" << size << "bytes";
+                continue;
+            }
+            if (sensor.sequenceTracker.update(record, flags)) {
+                latest = record;
+                // keep the gap flag even if it was raised by a record we are not publishing
+                latestFlags = flags | (latestFlags & ati_rdt::RDT_SAMPLE_GAP);
+                accepted = true;
+            }
+        }
+
+        if (!accepted) {
+            return;
+        }
+        sensor.lastSampleTime = arrivalTime;
+
+        double wrench[6];
+        sensor.wrenchTransform.apply(latest.FTData, wrench);
+
+        int status = yarp::dev::IAnalogSensor::AS_OK;
+        if (latestFlags & ati_rdt::RDT_SAMPLE_STATUS_ERROR) {
+            status = yarp::dev::IAnalogSensor::AS_ERROR;
+        }
+        else if (latestFlags & ati_rdt::RDT_SAMPLE_STATUS_OVERFLOW) {
+            status = yarp::dev::IAnalogSensor::AS_OVF;
+        }
+
+        std::lock_guard<std::mutex> guard(sensor.mutex);
+        for (int i = 0; i < 6; ++i) {
+            sensor.wrench[i] = wrench[i];
+        }
+        sensor.timestamp.update(arrivalTime);
+        sensor.status = status;
+        sensor.sampleFlags = latestFlags;
+        sensor.statistics = sensor.sequenceTracker.statistics();
+    }
+
+    /* Flag silent sensors and ask them to stream again */
+    void checkTimeouts(double now)
+    {
+        for (size_t i = 0; i < manager.m_sensors.size(); ++i) {
+            NetFTConnection &sensor = *manager.m_sensors[i];
+            if (now - sensor.lastSampleTime <= manager.m_timeout) {
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> guard(sensor.mutex);
+                sensor.status = yarp::dev::IAnalogSensor::AS_TIMEOUT;
+            }
+            if (now - sensor.lastRequestTime > manager.m_timeout) {
+                // The box may have been rebooted or the stream request lost: request it again
+                if (sendRequest(sensor, ati_rdt::RDT_COMMAND_START_HIGH_SPEED_STREAMING, ati_rdt::RDT_INFINITE_SAMPLES)) {
+                    sensor.sequenceTracker.startStream();
+                }
+                sensor.lastRequestTime = now;
+            }
+        }
+    }
+
+public:
+    NetFTReaderThread(yarp::dev::ati_netftManager &_manager)
+        : manager(_manager), epollHandle(-1), stopEvent(-1) {}
+
+    virtual ~NetFTReaderThread()
+    {
+        if (stopEvent >= 0) ::close(stopEvent);
+        if (epollHandle >= 0) ::close(epollHandle);
+    }
+
+    virtual bool threadInit()
+    {
+        epollHandle = epoll_create1(EPOLL_CLOEXEC);
+        stopEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollHandle < 0 || stopEvent < 0) {
+            yError() << "ati_netftManager: failed to create the epoll set:" << strerror(errno);
+            return false;
+        }
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u32 = STOP_EVENT_ID;
+        if (epoll_ctl(epollHandle, EPOLL_CTL_ADD, stopEvent, &event) < 0) {
+            yError() << "ati_netftManager: failed to register the stop event:" << strerror(errno);
+            return false;
+        }
+        for (size_t i = 0; i < manager.m_sensors.size(); ++i) {
+            event.data.u32 = static_cast<uint32_t>(i);
+            if (epoll_ctl(epollHandle, EPOLL_CTL_ADD, manager.m_sensors[i]->socketHandle, &event) < 0) {
+                yError() << "ati_netftManager: failed to register sensor" << manager.m_sensors[i]->sensorID << ":" << strerror(errno);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    virtual void onStop()
+    {
+        uint64_t one = 1;
+        if (write(stopEvent, &one, sizeof(one)) < 0) {
+            yError() << "ati_netftManager: failed to wake up the reader thread:" << strerror(errno);
+        }
+    }
+
+    virtual void run()
+    {
+        const int maxEvents = 16;
+        struct epoll_event events[maxEvents];
+        // Wake up at least twice per timeout to detect silent sensors
+        int waitMilliseconds = static_cast<int>(manager.m_timeout * 500.0);
+        if (waitMilliseconds < 1) waitMilliseconds = 1;
+
+        while (!isStopping()) {
+            int ready = epoll_wait(epollHandle, events, maxEvents, waitMilliseconds);
+            double now = yarp::os::Time::now();
+            if (ready < 0 && errno != EINTR) {
+                yError() << "ati_netftManager: epoll_wait failed:" << strerror(errno);
+                break;
+            }
+            for (int i = 0; i < ready; ++i) {
+                if (events[i].data.u32 == STOP_EVENT_ID) {
+                    return;
+                }
+                drain(*manager.m_sensors[events[i].data.u32], now);
+            }
+            checkTimeouts(now);
+        }
+    }
+};
+
+
+yarp::dev::ati_netftManager::ati_netftManager()
+    : m_timeout(0.1)
+    , m_reader(0)
+{
+}
+
+yarp::dev::ati_netftManager::~ati_netftManager()
+{
+    close();
+}
+
+yarp::dev::ati_netftManager::ati_netftManager(const yarp::dev::ati_netftManager& /*other*/)
+{
+    // Copy is disabled
+    assert(false);
+}
+
+yarp::dev::ati_netftManager& yarp::dev::ati_netftManager::operator=(const yarp::dev::ati_netftManager& /*other*/)
+{
+    // Copy is disabled
+    assert(false);
+    return *this;
+}
+
+bool yarp::dev::ati_netftManager::sendRequest(NetFTConnection &sensor, uint16_t command, uint32_t sampleCount)
+{
+    unsigned char request[ati_rdt::RDT_REQUEST_SIZE];
+    ati_rdt::encodeRequest(command, sampleCount, request);
+    if (send(sensor.socketHandle, request, sizeof(request), 0) < 0) {
+        yError() << "ati_netftManager: sensor" << sensor.sensorID << "failed to send the request:" << strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool yarp::dev::ati_netftManager::openSensor(const std::string &sensorID, yarp::os::Searchable &config)
+{
+    yarp::os::Searchable &group = config.findGroup(sensorID);
+    if (group.isNull()) {
+        yError() << "ati_netftManager: group" << sensorID << "not found in the configuration";
+        return false;
+    }
+
+    NetFTConnection *sensor = new NetFTConnection();
+    sensor->sensorID = sensorID;
+    sensor->socketHandle = -1;
+    sensor->lastRequestTime = 0;
+    sensor->lastSampleTime = yarp::os::Time::now();
+    sensor->status = yarp::dev::IAnalogSensor::AS_TIMEOUT;
+    sensor->sampleFlags = ati_rdt::RDT_SAMPLE_OK;
+    for (int i = 0; i < 6; ++i) sensor->wrench[i] = 0;
+    memset(&sensor->statistics, 0, sizeof(sensor->statistics));
+    m_sensors.push_back(sensor);
+
+    std::string ipAddress = group.find("ipAddress").asString();
+    std::string calibrationFile = group.find("calibrationFile").asString();
+    if (ipAddress.empty() || calibrationFile.empty()) {
+        yError() << "ati_netftManager: sensor" << sensorID << "requires ipAddress and calibrationFile";
+        return false;
+    }
+
+    std::string error;
+    if (!ati_rdt::loadCalibrationFile(calibrationFile, sensor->calibration, error)) {
+        yError() << "ati_netftManager: sensor" << sensorID << "invalid calibration file:" << error;
+        return false;
+    }
+    yInfo() << "ati_netftManager: sensor" << sensorID << "loaded calibration" << sensor->calibration.calibrationPartNumber
+            << "of sensor" << sensor->calibration.serialNumber;
+
+    if (!sensor->wrenchTransform.configure(sensor->calibration, group, "ati_netftManager: sensor " + sensorID + ":")) {
+        return false;
+    }
+
+    uint32_t errorMask = group.check("statusErrorMask", yarp::os::Value(static_cast<int>(ati_rdt::RDT_STATUS_DEFAULT_ERROR_MASK))).asInt32();
+    uint32_t overflowMask = group.check("statusOverflowMask", yarp::os::Value(static_cast<int>(ati_rdt::RDT_STATUS_DEFAULT_OVERFLOW_MASK))).asInt32();
+    sensor->sequenceTracker.setStatusMasks(errorMask, overflowMask);
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo *address = 0;
+    if (getaddrinfo(ipAddress.c_str(), 0, &hints, &address) != 0 || !address) {
+        yError() << "ati_netftManager: sensor" << sensorID << "could not resolve" << ipAddress;
+        return false;
+    }
+    memcpy(&sensor->addr, address->ai_addr, sizeof(sensor->addr));
+    freeaddrinfo(address);
+    sensor->addr.sin_family = AF_INET;
+    sensor->addr.sin_port = htons(ati_rdt::RDT_PORT);
+
+    sensor->socketHandle = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (sensor->socketHandle < 0) {
+        yError() << "ati_netftManager: sensor" << sensorID << "socket could not be opened:" << strerror(errno);
+        return false;
+    }
+    // Let the kernel buffer some records while the thread serves the other sensors
+    int receiveBuffer = group.check("receiveBufferSize", yarp::os::Value(64 * 1024), "socket receive buffer (bytes)").asInt32();
+    setsockopt(sensor->socketHandle, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+
+    // Connected socket: datagrams coming from other hosts are filtered by the kernel
+    if (connect(sensor->socketHandle, (struct sockaddr *)&sensor->addr, sizeof(sensor->addr)) < 0) {
+        yError() << "ati_netftManager: sensor" << sensorID << "socket could not connect:" << strerror(errno);
+        return false;
+    }
+
+    m_sensorIndices[sensorID] = static_cast<unsigned>(m_sensors.size() - 1);
+    yInfo() << "ati_netftManager: sensor" << sensorID << "at" << ipAddress << "associated to index" << m_sensors.size() - 1;
+    return true;
+}
+
+void yarp::dev::ati_netftManager::closeSensors()
+{
+    for (size_t i = 0; i < m_sensors.size(); ++i) {
+        NetFTConnection *sensor = m_sensors[i];
+        if (sensor->socketHandle >= 0) {
+            sendRequest(*sensor, ati_rdt::RDT_COMMAND_STOP_STREAMING, 0);
+            ::close(sensor->socketHandle);
+        }
+        delete sensor;
+    }
+    m_sensors.clear();
+    m_sensorIndices.clear();
+}
+
+bool yarp::dev::ati_netftManager::open(yarp::os::Searchable &config)
+{
+    if (m_reader) {
+        yError("ati_netftManager: device already opened");
+        return false;
+    }
+
+    m_timeout = config.check("timeout", yarp::os::Value(0.1), "seconds without records before timeout error (s)").asFloat64();
+    if (m_timeout <= 0) {
+        yError("ati_netftManager: timeout must be positive");
+        return false;
+    }
+
+    yarp::os::Bottle *sensorIDs = config.find("sensors").asList();
+    if (!sensorIDs || sensorIDs->size() == 0) {
+        yError("ati_netftManager: sensors list not found in the configuration");
+        return false;
+    }
+
+    for (size_t i = 0; i < sensorIDs->size(); ++i) {
+        std::string sensorID = sensorIDs->get(i).asString();
+        if (m_sensorIndices.find(sensorID) != m_sensorIndices.end()) {
+            yError() << "ati_netftManager: sensor" << sensorID << "listed twice";
+            closeSensors();
+            return false;
+        }
+        if (!openSensor(sensorID, config)) {
+            closeSensors();
+            return false;
+        }
+    }
+
+    // Start streaming; silent sensors will be asked again by the reader thread
+    double now = yarp::os::Time::now();
+    for (size_t i = 0; i < m_sensors.size(); ++i) {
+        NetFTConnection &sensor = *m_sensors[i];
+        sensor.sequenceTracker.startStream();
+        sendRequest(sensor, ati_rdt::RDT_COMMAND_START_HIGH_SPEED_STREAMING, ati_rdt::RDT_INFINITE_SAMPLES);
+        sensor.lastRequestTime = now;
+        sensor.lastSampleTime = now;
+    }
+
+    m_reader = new NetFTReaderThread(*this);
+    if (!m_reader->start()) {
+        yError("ati_netftManager: failed to start the reader thread");
+        delete m_reader;
+        m_reader = 0;
+        closeSensors();
+        return false;
+    }
+    return true;
+}
+
+bool yarp::dev::ati_netftManager::close()
+{
+    if (m_reader) {
+        m_reader->stop();
+        delete m_reader;
+        m_reader = 0;
+    }
+    closeSensors();
+    return true;
+}
+
+int yarp::dev::ati_netftManager::getNumberOfSensors()
+{
+    return static_cast<int>(m_sensors.size());
+}
+
+int yarp::dev::ati_netftManager::getSensorIndexForSensorID(const std::string& sensorID)
+{
+    std::unordered_map<std::string, unsigned>::const_iterator found = m_sensorIndices.find(sensorID);
+    return found == m_sensorIndices.end() ? -1 : static_cast<int>(found->second);
+}
+
+int yarp::dev::ati_netftManager::getLastMeasurementForSensorAtIndex(const unsigned sensorIndex,
+                                                                     yarp::sig::Vector& measurement,
+                                                                     yarp::os::Stamp *timestamp)
+{
+    if (sensorIndex >= m_sensors.size()) {
+        return yarp::dev::IAnalogSensor::AS_ERROR;
+    }
+    NetFTConnection &sensor = *m_sensors[sensorIndex];
+    if (measurement.size() != 6) {
+        measurement.resize(6);
+    }
+
+    std::lock_guard<std::mutex> guard(sensor.mutex);
+    for (int i = 0; i < 6; ++i) {
+        measurement[i] = sensor.wrench[i];
+    }
+    if (timestamp) {
+        *timestamp = sensor.timestamp;
+    }
+    return sensor.status;
+}
+
+yarp::os::Stamp yarp::dev::ati_netftManager::getLastInputStamp()
+{
+    yarp::os::Stamp latest;
+    for (size_t i = 0; i < m_sensors.size(); ++i) {
+        std::lock_guard<std::mutex> guard(m_sensors[i]->mutex);
+        if (m_sensors[i]->timestamp.getTime() > latest.getTime()) {
+            latest = m_sensors[i]->timestamp;
+        }
+    }
+    return latest;
+}
+
+bool yarp::dev::ati_netftManager::getRDTStatisticsForSensorAtIndex(const unsigned sensorIndex, ati_rdt::RDTStatistics &stats)
+{
+    if (sensorIndex >= m_sensors.size()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(m_sensors[sensorIndex]->mutex);
+    stats = m_sensors[sensorIndex]->statistics;
+    return true;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef YARP_ati_netftManager_H
+#define YARP_ati_netftManager_H
+
+#include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IPreciselyTimed.h>
+#include "IMultipleNetFTSensors.h"
+
+#include "ati_rdtProtocol.h"
+#include "ati_calibration.h"
+
+#include <yarp/sig/Vector.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <netinet/in.h>
+
+namespace yarp {
+    namespace dev {
+        class ati_netftManager;
+    }
+}
+
+/**
+ * Device owning N ATI Net F/T connections.
+ *
+ * All the sensors stream continuously (RDT high speed streaming) to their own UDP socket,
+ * and a single thread multiplexes the sockets with epoll, timestamps the datagrams on
+ * arrival, decodes them and publishes the last wrench of every sensor.
+ * Each sensor is exposed through the IMultipleNetFTSensors interface, to be used
+ * by one ati_netft_sensor device per sensor.
+ */
+class yarp::dev::ati_netftManager : public yarp::dev::IMultipleNetFTSensors,
+                                    public yarp::dev::DeviceDriver,
+                                    public yarp::dev::IPreciselyTimed
+{
+private:
+    // Prevent copy
+    ati_netftManager(const ati_netftManager &other);
+    ati_netftManager& operator=(const ati_netftManager &other);
+
+    struct NetFTConnection {
+        std::string sensorID;             /*!< name of the configuration group of the sensor */
+        int socketHandle;                 /*!< UDP socket connected to the Net F/T */
+        struct sockaddr_in addr;          /*!< Address of the Net F/T */
+        ati_rdt::NetFTCalibration calibration;
+        ati_rdt::WrenchTransform wrenchTransform;
+        ati_rdt::RDTSequenceTracker sequenceTracker; /*!< only accessed by the reader thread */
+        double lastRequestTime;           /*!< time of the last streaming request, only accessed by the reader thread */
+        double lastSampleTime;            /*!< arrival time of the last accepted record, only accessed by the reader thread */
+
+        // Published data, protected by mutex
+        std::mutex mutex;
+        double wrench[6];
+        yarp::os::Stamp timestamp;
+        int status;
+        int sampleFlags;
+        ati_rdt::RDTStatistics statistics;
+    };
+
+    std::vector<NetFTConnection*> m_sensors; /*!< immutable after open() */
+    std::unordered_map<std::string, unsigned> m_sensorIndices; /*!< sensor ID to index, immutable after open() */
+    double m_timeout; /*!< seconds without records before AS_TIMEOUT and a new streaming request */
+
+    //private class for reading from the sensors
+    class NetFTReaderThread;
+    NetFTReaderThread *m_reader; /*!< internal thread which reads data from all the sensors */
+
+    bool openSensor(const std::string &sensorID, yarp::os::Searchable &config);
+    static bool sendRequest(NetFTConnection &sensor, uint16_t command, uint32_t sampleCount);
+    void closeSensors();
+
+public:
+    ati_netftManager();
+    virtual ~ati_netftManager();
+
+    // DeviceDriver interface
+    bool open(yarp::os::Searchable &config);
+    bool close();
+
+    // IMultipleNetFTSensors interface
+    virtual int getNumberOfSensors();
+    virtual int getSensorIndexForSensorID(const std::string& sensorID);
+    virtual int getLastMeasurementForSensorAtIndex(const unsigned sensorIndex,
+                                                   yarp::sig::Vector& measurement,
+                                                   yarp::os::Stamp *timestamp);
+
+    // IPreciselyTimed interface
+    virtual yarp::os::Stamp getLastInputStamp();
+
+    /**
+     * Get the RDT counters of the sensor at the specified index
+     * @return false if the index is not valid
+     */
+    bool getRDTStatisticsForSensorAtIndex(const unsigned sensorIndex, ati_rdt::RDTStatistics &stats);
+};
+
+#endif // YARP_ati_netftManager_H
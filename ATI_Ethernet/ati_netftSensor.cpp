@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#include "ati_netftSensor.h"
+
+#include "IMultipleNetFTSensors.h"
+#include <yarp/os/LogStream.h>
+#include <yarp/dev/PolyDriver.h>
+#include <yarp/dev/PolyDriverList.h>
+
+#include <cassert>
+
+yarp::dev::ati_netftSensor::ati_netftSensor(const yarp::dev::ati_netftSensor &/*other*/) { assert(false); }
+yarp::dev::ati_netftSensor& yarp::dev::ati_netftSensor::operator = (const yarp::dev::ati_netftSensor &/*other*/) { assert(false); return *this; }
+
+yarp::dev::ati_netftSensor::ati_netftSensor()
+    : m_sensorReadings(6)
+    , m_status(AS_ERROR)
+    , m_manager(0)
+    , m_sensorIndex(-1)
+{
+    m_sensorReadings.zero();
+}
+
+yarp::dev::ati_netftSensor::~ati_netftSensor()
+{}
+
+// DeviceDriver interface
+bool yarp::dev::ati_netftSensor::open(yarp::os::Searchable &config)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_sensorID = config.find("sensorID").toString();
+    if (m_sensorID.empty()) {
+        yError("ati_netftSensor: sensorID not found in the configuration");
+        return false;
+    }
+    yInfo() << "ati_netftSensor: sensor with ID" << m_sensorID << "found";
+    return true;
+}
+
+bool yarp::dev::ati_netftSensor::close()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_manager = 0;
+    return true;
+}
+
+// IAnalogSensor interface
+int yarp::dev::ati_netftSensor::read(yarp::sig::Vector &out)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_manager) return AS_ERROR;
+    m_status = m_manager->getLastMeasurementForSensorAtIndex(m_sensorIndex,
+                                                             m_sensorReadings,
+                                                             &m_timestamp);
+    out = m_sensorReadings;
+    return m_status;
+}
+
+int yarp::dev::ati_netftSensor::getState(int /*ch*/)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_status;
+}
+
+int yarp::dev::ati_netftSensor::getChannels() { return 6; }
+int yarp::dev::ati_netftSensor::calibrateSensor() { return m_status; }
+int yarp::dev::ati_netftSensor::calibrateSensor(const yarp::sig::Vector &/*value*/) { return m_status; }
+int yarp::dev::ati_netftSensor::calibrateChannel(int /*ch*/) { return m_status; }
+int yarp::dev::ati_netftSensor::calibrateChannel(int /*ch*/, double /*value*/) { return m_status; }
+
+// IPreciselyTimed interface
+yarp::os::Stamp yarp::dev::ati_netftSensor::getLastInputStamp()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_timestamp;
+}
+
+// IWrapper interface
+bool yarp::dev::ati_netftSensor::attach(yarp::dev::PolyDriver *poly)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!poly || m_manager) return false;
+    if (!poly->view(m_manager) || !m_manager) return false;
+    m_sensorIndex = m_manager->getSensorIndexForSensorID(m_sensorID);
+    if (m_sensorIndex < 0) {
+        yError("ati_netftSensor: sensor with ID %s not handled by the attached device", m_sensorID.c_str());
+        m_manager = 0;
+        m_status = AS_ERROR;
+        return false;
+    }
+    yInfo("ati_netftSensor: sensor with ID %s associated to index %d", m_sensorID.c_str(), m_sensorIndex);
+    m_status = AS_OK;
+    return true;
+}
+
+bool yarp::dev::ati_netftSensor::detach()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_manager = 0;
+    m_status = AS_ERROR;
+    return true;
+}
+
+bool yarp::dev::ati_netftSensor::attachAll(const yarp::dev::PolyDriverList &driverList)
+{
+    if (driverList.size() != 1) {
+        yError("ati_netftSensor: exactly one device to be attached is supported");
+        return false;
+    }
+    const yarp::dev::PolyDriverDescriptor *firstDriver = driverList[0];
+    if (!firstDriver) {
+        yError("ati_netftSensor: failed to get the driver descriptor");
+        return false;
+    }
+    return attach(firstDriver->poly);
+}
+
+bool yarp::dev::ati_netftSensor::detachAll()
+{
+    return detach();
+}
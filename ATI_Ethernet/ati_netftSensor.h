@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef YARP_ati_netftSensor_H
+#define YARP_ati_netftSensor_H
+
+#include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IPreciselyTimed.h>
+#include <yarp/dev/IAnalogSensor.h>
+#include <yarp/dev/IWrapper.h>
+#include <yarp/dev/IMultipleWrapper.h>
+#include <yarp/sig/Vector.h>
+
+#include <string>
+#include <mutex>
+
+namespace yarp {
+    namespace dev {
+        class ati_netftSensor;
+        class IMultipleNetFTSensors;
+    }
+}
+
+/**
+ * One Net F/T sensor served by an ati_netft_manager device.
+ * The device attaches to the manager and exposes the sensor identified by sensorID
+ * as an IAnalogSensor, so that it can be wrapped by an analogServer.
+ */
+class yarp::dev::ati_netftSensor :
+    public yarp::dev::DeviceDriver,
+    public yarp::dev::IPreciselyTimed,
+    public yarp::dev::IAnalogSensor,
+    public yarp::dev::IWrapper,
+    public yarp::dev::IMultipleWrapper
+{
+    // Prevent copy
+    ati_netftSensor(const ati_netftSensor &other);
+    ati_netftSensor& operator=(const ati_netftSensor &other);
+
+    // Use a mutex to avoid race conditions
+    std::mutex m_mutex;
+
+    // Buffers of sensor data and timestamp
+    yarp::sig::Vector m_sensorReadings;
+    yarp::os::Stamp m_timestamp;
+
+    int m_status; /*!< status of the driver */
+    IMultipleNetFTSensors *m_manager; /*!< Pointer to the attached manager */
+    int m_sensorIndex; /*!< Index of the considered sensor */
+    std::string m_sensorID; /*!< Identifier of the considered sensor */
+
+public:
+
+    ati_netftSensor();
+    virtual ~ati_netftSensor();
+
+    // DeviceDriver interface
+    bool open(yarp::os::Searchable &config);
+    bool close();
+
+    // IAnalogSensor interface
+    virtual int read(yarp::sig::Vector &out);
+    virtual int getState(int ch);
+    virtual int getChannels();
+    virtual int calibrateSensor();
+    virtual int calibrateSensor(const yarp::sig::Vector &value);
+    virtual int calibrateChannel(int ch);
+    virtual int calibrateChannel(int ch, double value);
+
+    // IPreciselyTimed interface
+    virtual yarp::os::Stamp getLastInputStamp();
+
+    // IWrapper interface
+    virtual bool attach(yarp::dev::PolyDriver *poly);
+    virtual bool detach();
+
+    // IMultipleWrapper interface
+    virtual bool attachAll(const yarp::dev::PolyDriverList &);
+    virtual bool detachAll();
+
+};
+
+#endif // YARP_ati_netftSensor_H
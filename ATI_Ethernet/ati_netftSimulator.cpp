@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+/**
+ * ati_netft_simulator: loopback Net F/T RDT server.
+ *
+ * It answers the RDT requests (start streaming 0x0002, stop 0x0000, bias 0x0042) on UDP port 49152
+ * with synthetic (sine) or replayed wrenches, at a configurable rate, with optional loss,
+ * reordering and status word injection. The matching calibration file can be written to disk
+ * and/or served over HTTP, so that ati_ethernet and ati_netft_manager can be tested on localhost.
+ *
+ * Run ati_netft_simulator --help for the options.
+ */
+
+#include "ati_rdtProtocol.h"
+
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+    volatile sig_atomic_t stopRequested = 0;
+
+    void onSignal(int)
+    {
+        stopRequested = 1;
+    }
+
+    struct Options {
+        int port;
+        double rate;                 /*!< records per second */
+        double countsPerForce;
+        double countsPerTorque;
+        double amplitude[6];         /*!< sine amplitude, N and N-m */
+        double frequency;            /*!< sine frequency, Hz */
+        std::string replayFile;      /*!< if not empty, wrenches (6 columns, N and N-m) replayed in loop */
+        double lossProbability;      /*!< probability of dropping a record */
+        double reorderProbability;   /*!< probability of swapping a record with the next one */
+        uint32_t statusWord;         /*!< status word injected in the records */
+        unsigned statusEvery;        /*!< inject statusWord every N records (0 = never) */
+        std::string calibrationOut;  /*!< if not empty, the calibration file is written here */
+        int httpPort;                /*!< if > 0, the calibration file is served over HTTP on this port */
+        unsigned seed;
+    };
+
+    void printUsage()
+    {
+        std::cout <<
+            "Usage: ati_netft_simulator [options]\n"
+            "  --port <n>              RDT port (default 49152)\n"
+            "  --rate <Hz>             records per second while streaming (default 1000)\n"
+            "  --counts-per-force <n>  (default 1000000)\n"
+            "  --counts-per-torque <n> (default 1000000)\n"
+            "  --amplitude <f> <t>     sine amplitude of forces (N) and torques (N-m) (default 10 1)\n"
+            "  --frequency <Hz>        sine frequency (default 1)\n"
+            "  --replay <file>         replay wrenches from a text file (6 columns per line) instead of the sine\n"
+            "  --loss <p>              probability of dropping a record (default 0)\n"
+            "  --reorder <p>           probability of swapping a record with the following one (default 0)\n"
+            "  --status <word>         status word to inject (default 0x80000000)\n"
+            "  --status-every <n>      inject the status word every n records (default 0, never)\n"
+            "  --calibration-out <f>   write the matching calibration file\n"
+            "  --http-port <n>         serve the matching calibration file over HTTP\n"
+            "  --seed <n>              seed of the loss/reorder generator (default 0)\n";
+    }
+
+    bool parseOptions(int argc, char *argv[], Options &options)
+    {
+        options.port = ati_rdt::RDT_PORT;
+        options.rate = 1000;
+        options.countsPerForce = 1000000;
+        options.countsPerTorque = 1000000;
+        for (int i = 0; i < 3; ++i) {
+            options.amplitude[i] = 10;
+            options.amplitude[i + 3] = 1;
+        }
+        options.frequency = 1;
+        options.lossProbability = 0;
+        options.reorderProbability = 0;
+        options.statusWord = ati_rdt::RDT_STATUS_DEFAULT_ERROR_MASK;
+        options.statusEvery = 0;
+        options.httpPort = 0;
+        options.seed = 0;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string option = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (option == "--help" || option == "-h") {
+                return false;
+            }
+            else if (option == "--port" && hasValue) options.port = std::atoi(argv[++i]);
+            else if (option == "--rate" && hasValue) options.rate = std::atof(argv[++i]);
+            else if (option == "--counts-per-force" && hasValue) options.countsPerForce = std::atof(argv[++i]);
+            else if (option == "--counts-per-torque" && hasValue) options.countsPerTorque = std::atof(argv[++i]);
+            else if (option == "--amplitude" && i + 2 < argc) {
+                double force = std::atof(argv[++i]);
+                double torque = std::atof(argv[++i]);
+                for (int j = 0; j < 3; ++j) {
+                    options.amplitude[j] = force;
+                    options.amplitude[j + 3] = torque;
+                }
+            }
+            else if (option == "--frequency" && hasValue) options.frequency = std::atof(argv[++i]);
+            else if (option == "--replay" && hasValue) options.replayFile = argv[++i];
+            else if (option == "--loss" && hasValue) options.lossProbability = std::atof(argv[++i]);
+            else if (option == "--reorder" && hasValue) options.reorderProbability = std::atof(argv[++i]);
+            else if (option == "--status" && hasValue) options.statusWord = static_cast<uint32_t>(std::strtoul(argv[++i], 0, 0));
+            else if (option == "--status-every" && hasValue) options.statusEvery = static_cast<unsigned>(std::atoi(argv[++i]));
+            else if (option == "--calibration-out" && hasValue) options.calibrationOut = argv[++i];
+            else if (option == "--http-port" && hasValue) options.httpPort = std::atoi(argv[++i]);
+            else if (option == "--seed" && hasValue) options.seed = static_cast<unsigned>(std::atoi(argv[++i]));
+            else {
+                std::cerr << "Unknown or incomplete option " << option << std::endl;
+                return false;
+            }
+        }
+        if (options.rate <= 0 || options.countsPerForce <= 0 || options.countsPerTorque <= 0) {
+            std::cerr << "rate and counts must be positive" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool loadReplay(const std::string &fileName, std::vector<double> &wrenches)
+    {
+        std::ifstream file(fileName.c_str());
+        if (!file) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream values(line);
+            double wrench[6];
+            int count = 0;
+            while (count < 6 && values >> wrench[count]) {
+                count++;
+            }
+            if (count == 6) {
+                wrenches.insert(wrenches.end(), wrench, wrench + 6);
+            }
+        }
+        return !wrenches.empty();
+    }
+
+    /* Calibration file in the format downloaded from the Net F/T, with the counts used by the simulator */
+    std::string calibrationXML(const Options &options)
+    {
+        std::ostringstream xml;
+        xml.precision(15);
+        xml << "<?xml version=\"1.0\" standalone=\"yes\"?>\n"
+               "<dsNetFTCalibrationFile xmlns=\"http://tempuri.org/dsNetFTCalibrationFile.xsd\">\n"
+               "  <tblNetFTCalibrationInfo>\n"
+               "    <SerialNumber>SIM00001</SerialNumber>\n"
+               "    <BodyStyle>Simulated</BodyStyle>\n"
+               "    <CalibrationPartNumber>SIM-1</CalibrationPartNumber>\n"
+               "    <Family>Net F/T</Family>\n"
+               "    <CalibrationDate>2016-01-01T00:00:00</CalibrationDate>\n";
+        const char *axes[] = { "FX", "Fy", "Fz", "Tx", "Ty", "Tz" };
+        for (int i = 0; i < 6; ++i) {
+            xml << "    <Matrix" << axes[i] << ">";
+            for (int j = 0; j < 6; ++j) {
+                xml << (i == j ? 1 : 0) << " ";
+            }
+            xml << "</Matrix" << axes[i] << ">\n";
+        }
+        xml << "    <GaugeGains>0 0 0 0 0 0 </GaugeGains>\n"
+               "    <GaugeOffsets>0 0 0 0 0 0 </GaugeOffsets>\n"
+               "    <CalibrationIndex>1</CalibrationIndex>\n"
+               "  </tblNetFTCalibrationInfo>\n"
+               "  <tblCalibrationInformation>\n"
+               "    <CalibrationPartNumber>SIM-1</CalibrationPartNumber>\n"
+               "    <ForceUnits>N</ForceUnits>\n"
+               "    <TorqueUnits>N-m</TorqueUnits>\n"
+               "    <CountsPerForce>" << options.countsPerForce << "</CountsPerForce>\n"
+               "    <CountsPerTorque>" << options.countsPerTorque << "</CountsPerTorque>\n"
+               "    <MaxRatings>";
+        for (int i = 0; i < 6; ++i) {
+            xml << options.amplitude[i] * 2 << " ";
+        }
+        xml << "</MaxRatings>\n"
+               "  </tblCalibrationInformation>\n"
+               "</dsNetFTCalibrationFile>\n";
+        return xml.str();
+    }
+
+    void serveHTTP(int listenSocket, const std::string &body)
+    {
+        int client = accept(listenSocket, 0, 0);
+        if (client < 0) {
+            return;
+        }
+        // The request content is not relevant: every GET receives the calibration file
+        char request[1024];
+        if (recv(client, request, sizeof(request), 0) < 0) {
+            close(client);
+            return;
+        }
+        std::ostringstream response;
+        response << "HTTP/1.0 200 OK\r\n"
+                    "Content-Type: text/xml\r\n"
+                    "Content-Length: " << body.size() << "\r\n"
+                    "Connection: close\r\n\r\n" << body;
+        std::string data = response.str();
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t written = send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0) break;
+            sent += written;
+        }
+        close(client);
+    }
+
+    double seconds(const struct timespec &time)
+    {
+        return time.tv_sec + time.tv_nsec * 1e-9;
+    }
+
+    struct timespec toTimespec(double value)
+    {
+        struct timespec time;
+        time.tv_sec = static_cast<time_t>(value);
+        time.tv_nsec = static_cast<long>((value - time.tv_sec) * 1e9);
+        return time;
+    }
+
+    double monotonicNow()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return seconds(now);
+    }
+
+    /**
+     * Streaming state towards the last client that asked for records
+     */
+    struct Stream {
+        bool active;
+        struct sockaddr_in client;
+        uint32_t remaining;          /*!< records still to be sent, 0 = infinite */
+        uint32_t rdtSequence;        /*!< restarts from 1 at every request */
+        double nextRecordTime;
+        bool hasHeldRecord;          /*!< record held back to be sent after the next one (reordering) */
+        unsigned char heldRecord[ati_rdt::RDT_RECORD_SIZE];
+    };
+
+    struct Counters {
+        unsigned long requests;
+        unsigned long sent;
+        unsigned long dropped;
+        unsigned long reordered;
+        unsigned long biased;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<double> replay;
+    if (!options.replayFile.empty() && !loadReplay(options.replayFile, replay)) {
+        std::cerr << "Could not read wrenches from " << options.replayFile << std::endl;
+        return 1;
+    }
+
+    const std::string calibration = calibrationXML(options);
+    if (!options.calibrationOut.empty()) {
+        std::ofstream out(options.calibrationOut.c_str());
+        out << calibration;
+        if (!out) {
+            std::cerr << "Could not write " << options.calibrationOut << std::endl;
+            return 1;
+        }
+        std::cout << "Calibration file written to " << options.calibrationOut << std::endl;
+    }
+
+    int rdtSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(options.port);
+    if (rdtSocket < 0 || bind(rdtSocket, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        std::cerr << "Could not bind the RDT port " << options.port << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+    int sendBuffer = 1 << 20;
+    setsockopt(rdtSocket, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+
+    int httpSocket = -1;
+    if (options.httpPort > 0) {
+        httpSocket = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(httpSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        address.sin_port = htons(options.httpPort);
+        if (httpSocket < 0 || bind(httpSocket, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(httpSocket, 4) < 0) {
+            std::cerr << "Could not listen on the HTTP port " << options.httpPort << ": " << strerror(errno) << std::endl;
+            return 1;
+        }
+        std::cout << "Serving the calibration file on http port " << options.httpPort << std::endl;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    std::mt19937 generator(options.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    Stream stream;
+    memset(&stream, 0, sizeof(stream));
+    Counters counters;
+    memset(&counters, 0, sizeof(counters));
+
+    const double period = 1.0 / options.rate;
+    const double startTime = monotonicNow();
+    uint32_t ftSequence = 0;
+    int32_t bias[6] = { 0, 0, 0, 0, 0, 0 };
+    int32_t lastCounts[6] = { 0, 0, 0, 0, 0, 0 };
+    size_t replayIndex = 0;
+
+    std::cout << "Net F/T simulator listening on UDP port " << options.port << ", " << options.rate << " Hz" << std::endl;
+
+    while (!stopRequested) {
+        struct pollfd fds[2];
+        fds[0].fd = rdtSocket;
+        fds[0].events = POLLIN;
+        fds[1].fd = httpSocket;
+        fds[1].events = POLLIN;
+        int numberOfFds = httpSocket >= 0 ? 2 : 1;
+
+        double now = monotonicNow();
+        double wait = stream.active ? stream.nextRecordTime - now : 0.1;
+        if (wait < 0) wait = 0;
+        struct timespec timeout = toTimespec(wait);
+        int ready = ppoll(fds, numberOfFds, &timeout, 0);
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "poll failed: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            unsigned char request[64];
+            struct sockaddr_in client;
+            socklen_t clientSize = sizeof(client);
+            ssize_t size = recvfrom(rdtSocket, request, sizeof(request), 0, (struct sockaddr *)&client, &clientSize);
+            uint16_t command;
+            uint32_t sampleCount;
+            if (size > 0 && ati_rdt::decodeRequest(request, size, command, sampleCount)) {
+                counters.requests++;
+                switch (command) {
+                case ati_rdt::RDT_COMMAND_START_HIGH_SPEED_STREAMING:
+                    stream.active = true;
+                    stream.client = client;
+                    stream.remaining = sampleCount;
+                    stream.rdtSequence = 0;
+                    stream.hasHeldRecord = false;
+                    stream.nextRecordTime = monotonicNow();
+                    break;
+                case ati_rdt::RDT_COMMAND_STOP_STREAMING:
+                    stream.active = false;
+                    break;
+                case ati_rdt::RDT_COMMAND_SET_SOFTWARE_BIAS:
+                    // The Net F/T biases on the current reading, without interrupting the stream
+                    for (int i = 0; i < 6; ++i) bias[i] = lastCounts[i];
+                    counters.biased++;
+                    break;
+                default:
+                    std::cerr << "Unsupported RDT command 0x" << std::hex << command << std::dec << std::endl;
+                    break;
+                }
+            }
+        }
+
+        if (httpSocket >= 0 && ready > 0 && (fds[1].revents & POLLIN)) {
+            serveHTTP(httpSocket, calibration);
+        }
+
+        // Send every record that is due, without bursting more than a few after a stall
+        now = monotonicNow();
+        int burst = 0;
+        while (stream.active && now >= stream.nextRecordTime && burst < 16) {
+            burst++;
+            stream.nextRecordTime += period;
+            ftSequence++;
+            stream.rdtSequence++;
+
+            double wrench[6];
+            if (!replay.empty()) {
+                for (int i = 0; i < 6; ++i) wrench[i] = replay[replayIndex * 6 + i];
+                replayIndex = (replayIndex + 1) % (replay.size() / 6);
+            }
+            else {
+                double phase = 2 * M_PI * options.frequency * (stream.nextRecordTime - startTime);
+                for (int i = 0; i < 6; ++i) wrench[i] = options.amplitude[i] * std::sin(phase + i * M_PI / 3);
+            }
+
+            ati_rdt::RDTRecord record;
+            record.rdt_sequence = stream.rdtSequence;
+            record.ft_sequence = ftSequence;
+            record.status = (options.statusEvery > 0 && ftSequence % options.statusEvery == 0) ? options.statusWord : 0;
+            for (int i = 0; i < 6; ++i) {
+                double counts = wrench[i] * (i < 3 ? options.countsPerForce : options.countsPerTorque);
+                lastCounts[i] = static_cast<int32_t>(std::lround(counts));
+                record.FTData[i] = lastCounts[i] - bias[i];
+            }
+
+            if (stream.remaining > 0 && --stream.remaining == 0) {
+                stream.active = false;
+            }
+
+            if (uniform(generator) < options.lossProbability) {
+                counters.dropped++;
+                continue;
+            }
+            unsigned char raw[ati_rdt::RDT_RECORD_SIZE];
+            ati_rdt::encodeRecord(record, raw);
+            if (!stream.hasHeldRecord && stream.active && uniform(generator) < options.reorderProbability) {
+                memcpy(stream.heldRecord, raw, sizeof(raw));
+                stream.hasHeldRecord = true;
+                counters.reordered++;
+                continue;
+            }
+            sendto(rdtSocket, raw, sizeof(raw), 0, (struct sockaddr *)&stream.client, sizeof(stream.client));
+            counters.sent++;
+            if (stream.hasHeldRecord) {
+                sendto(rdtSocket, stream.heldRecord, sizeof(stream.heldRecord), 0, (struct sockaddr *)&stream.client, sizeof(stream.client));
+                stream.hasHeldRecord = false;
+                counters.sent++;
+            }
+        }
+        if (stream.active && now - stream.nextRecordTime > 16 * period) {
+            // Too late to catch up: skip the missed records, as the box would
+            ftSequence += static_cast<uint32_t>((now - stream.nextRecordTime) / period);
+            stream.nextRecordTime = now;
+        }
+    }
+
+    std::cout << "requests " << counters.requests << ", sent " << counters.sent << ", dropped " << counters.dropped
+              << ", reordered " << counters.reordered << ", biased " << counters.biased << std::endl;
+    close(rdtSocket);
+    if (httpSocket >= 0) close(httpSocket);
+    return 0;
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2016 iCub Facility
+ * Authors: Francisco Andrade
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+ */
+
+#ifndef YARP_ati_rdtProtocol_H
+#define YARP_ati_rdtProtocol_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <winsock2.h>
+#else
+	#include <arpa/inet.h>
+#endif
+
+/**
+ * Helpers for the Raw Data Transfer (RDT) UDP protocol spoken by the ATI Net F/T box.
+ * Reference: section 9 of the Net F/T user manual.
+ */
+namespace ati_rdt {
+
+const uint16_t RDT_PORT = 49152;          /*!< Port the Net F/T always uses */
+const uint16_t RDT_REQUEST_HEADER = 0x1234; /*!< Standard header of every RDT request */
+const size_t RDT_REQUEST_SIZE = 8;        /*!< Size in bytes of an RDT request */
+const size_t RDT_RECORD_SIZE = 36;        /*!< Size in bytes of an RDT record */
+
+/**
+ * RDT command codes (table 9.1 of the Net F/T user manual)
+ */
+enum RDTCommand {
+    RDT_COMMAND_STOP_STREAMING = 0x0000,
+    RDT_COMMAND_START_HIGH_SPEED_STREAMING = 0x0002,
+    RDT_COMMAND_SET_SOFTWARE_BIAS = 0x0042
+};
+
+const uint32_t RDT_INFINITE_SAMPLES = 0; /*!< sample count asking the Net F/T to stream until stopped */
+
+/**
+ * Encode an RDT request
+ * @param command one of RDTCommand
+ * @param sampleCount number of records requested (RDT_INFINITE_SAMPLES to stream until stopped)
+ * @param[out] request buffer of RDT_REQUEST_SIZE bytes
+ */
+inline void encodeRequest(uint16_t command, uint32_t sampleCount, unsigned char *request)
+{
+    uint16_t header = htons(RDT_REQUEST_HEADER);
+    uint16_t code = htons(command);
+    uint32_t count = htonl(sampleCount);
+    memcpy(request + 0, &header, 2);
+    memcpy(request + 2, &code, 2);
+    memcpy(request + 4, &count, 4);
+}
+
+/**
+ * Decode an RDT request. Returns false if the size or the header are not valid.
+ */
+inline bool decodeRequest(const unsigned char *request, size_t size, uint16_t &command, uint32_t &sampleCount)
+{
+    if (size < RDT_REQUEST_SIZE) {
+        return false;
+    }
+    uint16_t header, code;
+    uint32_t count;
+    memcpy(&header, request + 0, 2);
+    memcpy(&code, request + 2, 2);
+    memcpy(&count, request + 4, 4);
+    if (ntohs(header) != RDT_REQUEST_HEADER) {
+        return false;
+    }
+    command = ntohs(code);
+    sampleCount = ntohl(count);
+    return true;
+}
+
+/**
+ * One RDT record, already converted to host byte order
+ */
+struct RDTRecord {
+    uint32_t rdt_sequence; /*!< Position of the record in the current output stream (1 for the first record) */
+    uint32_t ft_sequence;  /*!< Internal sample number of the F/T record */
+    uint32_t status;       /*!< System status code */
+    int32_t FTData[6];     /*!< Force and torque, in counts */
+};
+
+/**
+ * Decode a raw RDT record. Returns false if the datagram is too short.
+ */
+inline bool decodeRecord(const unsigned char *raw, size_t size, RDTRecord &record)
+{
+    if (size < RDT_RECORD_SIZE) {
+        return false;
+    }
+    uint32_t word;
+    memcpy(&word, raw + 0, 4); record.rdt_sequence = ntohl(word);
+    memcpy(&word, raw + 4, 4); record.ft_sequence = ntohl(word);
+    memcpy(&word, raw + 8, 4); record.status = ntohl(word);
+    for (int i = 0; i < 6; ++i) {
+        memcpy(&word, raw + 12 + i * 4, 4);
+        record.FTData[i] = static_cast<int32_t>(ntohl(word));
+    }
+    return true;
+}
+
+/**
+ * Encode a record as sent by the Net F/T
+ * @param[out] raw buffer of RDT_RECORD_SIZE bytes
+ */
+inline void encodeRecord(const RDTRecord &record, unsigned char *raw)
+{
+    uint32_t word;
+    word = htonl(record.rdt_sequence); memcpy(raw + 0, &word, 4);
+    word = htonl(record.ft_sequence); memcpy(raw + 4, &word, 4);
+    word = htonl(record.status); memcpy(raw + 8, &word, 4);
+    for (int i = 0; i < 6; ++i) {
+        word = htonl(static_cast<uint32_t>(record.FTData[i]));
+        memcpy(raw + 12 + i * 4, &word, 4);
+    }
+}
+
+/**
+ * Flags attached to every sample by the RDTSequenceTracker
+ */
+enum RDTSampleFlags {
+    RDT_SAMPLE_OK = 0,
+    RDT_SAMPLE_GAP = 1 << 0,             /*!< one or more records were lost before this one */
+    RDT_SAMPLE_REORDERED = 1 << 1,       /*!< record older than the last accepted one (discarded) */
+    RDT_SAMPLE_DUPLICATE = 1 << 2,       /*!< same record received twice (discarded) */
+    RDT_SAMPLE_STATUS_ERROR = 1 << 3,    /*!< status word reports an error */
+    RDT_SAMPLE_STATUS_OVERFLOW = 1 << 4  /*!< status word reports a saturated/out of range gage */
+};
+
+/**
+ * Default masks applied to the status word.
+ * Bit 31 is set by the Net F/T whenever an error condition is active, the overflow mask selects the
+ * gage saturation/out of range bits. Check the status code table of the Net F/T manual for your firmware.
+ */
+const uint32_t RDT_STATUS_DEFAULT_ERROR_MASK = 0x80000000u;
+const uint32_t RDT_STATUS_DEFAULT_OVERFLOW_MASK = 0x00030000u;
+
+/**
+ * Counters accumulated by the RDTSequenceTracker
+ */
+struct RDTStatistics {
+    uint64_t receivedRecords;   /*!< records received (accepted or not) */
+    uint64_t acceptedRecords;   /*!< records published to the user */
+    uint64_t lostRecords;       /*!< records missing from the rdt_sequence */
+    uint64_t reorderedRecords;  /*!< records arrived after a newer one */
+    uint64_t duplicatedRecords; /*!< records received more than once */
+    uint64_t sensorSamples;     /*!< internal F/T samples elapsed, counted on ft_sequence */
+    uint64_t errorRecords;      /*!< records with the error bits set in the status word */
+    uint64_t overflowRecords;   /*!< records with the overflow bits set in the status word */
+    uint32_t lastStatus;        /*!< last status word received */
+};
+
+/**
+ * Tracks rdt_sequence/ft_sequence of the incoming records to detect lost, reordered and
+ * duplicated datagrams, and maps the status word to sample flags.
+ * Sequence numbers are compared with modular arithmetic, so wraparound is handled.
+ */
+class RDTSequenceTracker {
+public:
+    RDTSequenceTracker()
+        : m_errorMask(RDT_STATUS_DEFAULT_ERROR_MASK)
+        , m_overflowMask(RDT_STATUS_DEFAULT_OVERFLOW_MASK)
+    {
+        reset();
+    }
+
+    void setStatusMasks(uint32_t errorMask, uint32_t overflowMask)
+    {
+        m_errorMask = errorMask;
+        m_overflowMask = overflowMask;
+    }
+
+    /**
+     * Clear all the counters
+     */
+    void reset()
+    {
+        memset(&m_stats, 0, sizeof(m_stats));
+        m_streamStarted = false;
+        m_hasFtSequence = false;
+        m_lastRdtSequence = 0;
+        m_lastFtSequence = 0;
+    }
+
+    /**
+     * To be called every time a new request is sent: the Net F/T restarts rdt_sequence from 1
+     */
+    void startStream()
+    {
+        m_streamStarted = true;
+        m_lastRdtSequence = 0;
+    }
+
+    /**
+     * Account a new record.
+     * @param record the decoded record
+     * @param[out] flags combination of RDTSampleFlags for this record
+     * @return true if the record is newer than the last accepted one and should be published
+     */
+    bool update(const RDTRecord &record, int &flags)
+    {
+        flags = RDT_SAMPLE_OK;
+        m_stats.receivedRecords++;
+        m_stats.lastStatus = record.status;
+
+        if (record.status & m_errorMask) {
+            flags |= RDT_SAMPLE_STATUS_ERROR;
+            m_stats.errorRecords++;
+        }
+        if (record.status & m_overflowMask) {
+            flags |= RDT_SAMPLE_STATUS_OVERFLOW;
+            m_stats.overflowRecords++;
+        }
+
+        // ft_sequence is never reset by the box, so it tells us if the record is stale
+        // even across different streams
+        if (m_hasFtSequence) {
+            int32_t ftDelta = static_cast<int32_t>(record.ft_sequence - m_lastFtSequence);
+            if (ftDelta == 0) {
+                flags |= RDT_SAMPLE_DUPLICATE;
+                m_stats.duplicatedRecords++;
+                return false;
+            }
+            if (ftDelta < 0) {
+                flags |= RDT_SAMPLE_REORDERED;
+                m_stats.reorderedRecords++;
+                return false;
+            }
+            m_stats.sensorSamples += static_cast<uint32_t>(ftDelta);
+        }
+        m_hasFtSequence = true;
+        m_lastFtSequence = record.ft_sequence;
+
+        if (!m_streamStarted) {
+            // First record ever seen without an explicit startStream: take it as reference
+            m_streamStarted = true;
+            m_lastRdtSequence = record.rdt_sequence - 1;
+        }
+        uint32_t rdtDelta = record.rdt_sequence - m_lastRdtSequence;
+        if (rdtDelta > 1 && static_cast<int32_t>(rdtDelta) > 0) {
+            flags |= RDT_SAMPLE_GAP;
+            m_stats.lostRecords += rdtDelta - 1;
+        }
+        m_lastRdtSequence = record.rdt_sequence;
+
+        m_stats.acceptedRecords++;
+        return true;
+    }
+
+    const RDTStatistics& statistics() const { return m_stats; }
+
+private:
+    uint32_t m_errorMask;
+    uint32_t m_overflowMask;
+    RDTStatistics m_stats;
+    bool m_streamStarted;
+    bool m_hasFtSequence;
+    uint32_t m_lastRdtSequence;
+    uint32_t m_lastFtSequence;
+};
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/*
+* Copyright (C) 2016 iCub Facility
+* Authors: Francesco Romano
+* CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+*/
+
+#ifndef AMTICLOCKESTIMATOR_H
+#define AMTICLOCKESTIMATOR_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Maps the sample counter of an amplifier to the local (YARP) clock.
+ *
+ * Each data block gives an observation (counter of its newest sample, arrival time).
+ * The arrival is always later than the sample, by the transfer and scheduling delays:
+ * the mapping is a line whose slope (the sample period, including the drift of the amplifier clock)
+ * is fitted on the least delayed of the last observations and which is shifted to lie below all of them.
+ *
+ * When the amplifier sees a sync (genlock) edge, the counter of the edge can be set as the phase reference
+ * of the mapping: the edge keeps the time estimated when it has been seen, and the following samples
+ * are placed at whole periods from it, so that the streams of the devices sharing the sync signal
+ * can be aligned on the edges. The time of the edge itself is still an estimate from the arrival times,
+ * and an anchor drifting from them by half a period (edges too sparse for the accuracy of the period) is dropped.
+ */
+class AMTIClockEstimator
+{
+public:
+    AMTIClockEstimator()
+        : m_nominalPeriod(0)
+        , m_maxDrift(0)
+        , m_next(0)
+        , m_count(0)
+        , m_referenceCounter(0)
+        , m_offset(0)
+        , m_period(0)
+        , m_anchored(false)
+        , m_anchorCounter(0)
+        , m_anchorTime(0) {}
+
+    /**
+     * Discard the observations
+     * @param nominalPeriod expected time between two counter increments (s)
+     * @param window number of observations used for the estimate
+     * @param maxDrift maximum relative difference between the estimated and the nominal period
+     */
+    void reset(double nominalPeriod, unsigned window, double maxDrift = 0.005)
+    {
+        m_nominalPeriod = nominalPeriod;
+        m_maxDrift = maxDrift;
+        m_counters.assign(std::max(window, 2u), 0.0);
+        m_arrivals.assign(m_counters.size(), 0.0);
+        m_next = 0;
+        m_count = 0;
+        m_referenceCounter = 0;
+        m_offset = 0;
+        m_period = nominalPeriod;
+        m_anchored = false;
+    }
+
+    /**
+     * True if at least one observation has been added since the last reset
+     */
+    bool valid() const { return m_count > 0; }
+
+    /**
+     * Estimated time between two counter increments (s)
+     */
+    double period() const { return m_period; }
+
+    /**
+     * Add an observation and update the estimate
+     * @param counter counter of the sample
+     * @param arrivalTime local time at which the sample has been received
+     */
+    void update(double counter, double arrivalTime)
+    {
+        const size_t window = m_counters.size();
+        m_counters[m_next] = counter;
+        m_arrivals[m_next] = arrivalTime;
+        m_next = (m_next + 1) % window;
+        if (m_count < window) m_count++;
+        m_referenceCounter = counter;
+
+        // The slope is fitted on the observation with the smallest delay of each segment of the window,
+        // as the delays are far noisier than the amplifier clock.
+        // Counters are relative to the newest one for accuracy
+        const size_t segments = std::min<size_t>(8, m_count);
+        double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+        for (size_t segment = 0; segment < segments; ++segment) {
+            double bestX = 0, bestY = 0, bestDelay = 0;
+            for (size_t i = segment * m_count / segments; i < (segment + 1) * m_count / segments; ++i) {
+                size_t index = (m_next + window - m_count + i) % window;
+                double x = m_counters[index] - counter;
+                double y = m_arrivals[index] - arrivalTime;
+                double delay = y - x * m_nominalPeriod;
+                if (i == segment * m_count / segments || delay < bestDelay) {
+                    bestX = x;
+                    bestY = y;
+                    bestDelay = delay;
+                }
+            }
+            sumX += bestX;
+            sumY += bestY;
+            sumXY += bestX * bestY;
+            sumXX += bestX * bestX;
+        }
+        double denominator = segments * sumXX - sumX * sumX;
+        m_period = segments > 1 && denominator > 0 ? (segments * sumXY - sumX * sumY) / denominator : m_nominalPeriod;
+        m_period = std::min(std::max(m_period, m_nominalPeriod * (1 - m_maxDrift)), m_nominalPeriod * (1 + m_maxDrift));
+
+        // lower envelope: no sample can be received before it is acquired
+        m_offset = arrivalTime;
+        for (size_t i = 0; i < m_count; ++i) {
+            m_offset = std::min(m_offset, m_arrivals[i] - (m_counters[i] - counter) * m_period);
+        }
+
+        // without recent edges the error of the period accumulates from the anchor: it is dropped
+        // once it is half a period away from the arrivals
+        if (m_anchored && std::abs(m_anchorTime + (counter - m_anchorCounter) * m_period - m_offset) > m_period / 2) {
+            m_anchored = false;
+        }
+    }
+
+    /**
+     * Use the sample with the specified counter, the first after a sync edge, as phase reference
+     * @param counter counter of the sample
+     */
+    void anchor(double counter)
+    {
+        m_anchorTime = m_offset + (counter - m_referenceCounter) * m_period;
+        m_anchorCounter = counter;
+        m_anchored = true;
+    }
+
+    /**
+     * Local time at which the sample with the specified counter has been acquired
+     */
+    double timeOf(double counter) const
+    {
+        if (m_anchored) {
+            return m_anchorTime + (counter - m_anchorCounter) * m_period;
+        }
+        return m_offset + (counter - m_referenceCounter) * m_period;
+    }
+
+private:
+    double m_nominalPeriod;
+    double m_maxDrift;
+    std::vector<double> m_counters;
+    std::vector<double> m_arrivals;
+    size_t m_next;
+    size_t m_count;
+    double m_referenceCounter; /*!< counter of the newest observation */
+    double m_offset;           /*!< local time of the sample with counter m_referenceCounter */
+    double m_period;
+    bool m_anchored;           /*!< true if a sync edge has been seen since the last reset */
+    double m_anchorCounter;    /*!< counter of the first sample after the last sync edge */
+    double m_anchorTime;       /*!< local time of the sample with counter m_anchorCounter */
+};
+
+#endif // AMTICLOCKESTIMATOR_H
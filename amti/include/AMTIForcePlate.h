@@ -12,10 +12,7 @@
 #include <yarp/dev/IAnalogSensor.h>
 #include <yarp/dev/IWrapper.h>
 #include <yarp/dev/IMultipleWrapper.h>
-#include <yarp/sig/Matrix.h>
-
-#include <iDynTree/Core/Transform.h>
-#include <iDynTree/Core/Rotation.h>
+#include <yarp/sig/Vector.h>
 
 #include <string>
 #include <mutex>
@@ -42,9 +39,11 @@ class yarp::dev::AMTIForcePlate :
     // Use a mutex to avoid race conditions
     std::mutex m_mutex;
 
-    // Platform rotation
-    float m_rotation_angle; //Rotation about z axis
-    yarp::sig::Matrix m_transform_wrench;
+    // Platform pose, folded at open() in the matrix mapping a wrench (forces, moments)
+    // expressed in the platform frame to the world frame
+    double m_wrenchTransform[6][6];
+    // Origin of the platform frame in the world frame (m), for the center of pressure
+    double m_position[3];
 
     // Buffers of sensor data and timestamp
     yarp::sig::Vector m_sensorReadings;
@@ -65,6 +64,13 @@ public:
     bool close();
 
     // IAnalogSensor interface
+    /**
+     * Read the last measurement of the platform, expressed in the world frame: the wrench,
+     * then the derived quantities if the platforms driver computes them. The center of pressure
+     * is the world position of the point of the platform xy plane, the free moment its
+     * component about the world vertical axis. The combined center of pressure is left in the
+     * frame common to the platforms, set in the configuration of the platforms driver
+     */
     virtual int read(yarp::sig::Vector &out);
     virtual int getState(int ch);
     virtual int getChannels();
@@ -73,6 +79,15 @@ public:
     virtual int calibrateChannel(int ch);
     virtual int calibrateChannel(int ch, double value);
 
+    /**
+     * Express wrenches measured by the platform in the world frame
+     *
+     * @param[in] wrenches count wrenches (forces, moments) expressed in the platform frame
+     * @param[out] transformed buffer of count wrenches. It can be the same buffer as wrenches
+     * @param[in] count number of wrenches
+     */
+    void transformWrenches(const double *wrenches, double *transformed, unsigned count) const;
+
     // IPreciselyTimed interface
     virtual yarp::os::Stamp getLastInputStamp();
 
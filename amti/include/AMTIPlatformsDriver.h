@@ -11,10 +11,17 @@
 #include <yarp/dev/DeviceDriver.h>
 #include <yarp/dev/IPreciselyTimed.h>
 #include "IMultipleForcePlates.h"
+#include "IForcePlatesMetadata.h"
+#include "AMTISampleRing.h"
+#include "AMTIClockEstimator.h"
 
 #include <yarp/sig/Vector.h>
 
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_map>
 
 namespace yarp {
     namespace dev {
@@ -23,6 +30,7 @@ namespace yarp {
 }
 
 class yarp::dev::AMTIPlatformsDriver : public yarp::dev::IMultipleForcePlates,
+                                        public yarp::dev::IForcePlatesMetadata,
                                         public yarp::dev::DeviceDriver,
                                         public yarp::dev::IPreciselyTimed
 {
@@ -31,22 +39,67 @@ private:
     AMTIPlatformsDriver(const AMTIPlatformsDriver &other);
     AMTIPlatformsDriver& operator=(const AMTIPlatformsDriver &other);
 
-    // Use a mutex to avoid race conditions
+    // Serializes open() and close(). Readers of the data never take it
     std::mutex m_mutex;
-
-    // Buffers of sensor data and timestamp
-    yarp::sig::Vector m_sensorReadings;
-    yarp::os::Stamp m_timestamp;
-
-    // Properties of the sensor
+    // Serializes the calls to the AMTI SDK, which selects the device as a global state
+    std::mutex m_sdkMutex;
+
+    /**
+     * Samples of one platform, with the state used to reconstruct their timestamps
+     */
+    struct PlatformBuffer {
+        AMTISampleRing ring;        /*!< every dataset received, with its reconstructed timestamp */
+        AMTIClockEstimator clock;   /*!< maps the sample counter to the local time */
+        uint64_t firstCounter;      /*!< counter of the first sample of the block being ingested */
+        uint64_t lastCounter;       /*!< counter of the last sample received, rebuilt on 64 bits */
+        bool triggerActive;         /*!< state of the trigger (sync) input at the last sample */
+        std::atomic<uint64_t> lastSyncEdge; /*!< sequence number of the first sample after the last sync edge, 0 if none */
+    };
+
+    /**
+     * Geometry used to compute the derived quantities of one platform
+     */
+    struct PlateGeometry {
+        double surfaceHeight; /*!< z of the plate surface in the platform frame (m) */
+        double position[2];   /*!< origin of the platform frame in the common frame (m) */
+        double cosYaw;        /*!< rotation of the platform frame about the vertical axis of the common frame */
+        double sinYaw;
+    };
+
+    // Buffers of sensor data and timestamp.
+    // The rings are written by the reader thread only and read without locks (see AMTISampleRing)
+    std::unique_ptr<PlatformBuffer[]> m_platforms; /*!< one buffer for each platform */
+    std::vector<double> m_packet; /*!< last data block transferred by the AMTI driver, only accessed by the reader thread */
+    std::atomic<double> m_lastPacketTime; /*!< arrival time of the last data block */
+    std::atomic<int> m_packetCount; /*!< number of data blocks received */
+
+    // Properties of the sensor, immutable after open()
     unsigned m_numOfPlatforms; /*!< Number of platforms connected to the system */
     unsigned m_channelSize; /*!< Size of the data read from the platform */
-
-    //private class for reading from the sensor
+    double m_samplePeriod; /*!< Inverse of the acquisition rate (s) */
+    unsigned m_clockWindow; /*!< Number of data blocks used to estimate the clock of the amplifiers */
+    bool m_syncOnFallingEdge; /*!< Sync edges are the falling edges of the trigger channel (rising otherwise) */
+    double m_triggerThreshold; /*!< Value of the trigger channel above which the sync input is active */
+    std::vector<ForcePlateInfo> m_inventory; /*!< Description of each platform, captured at open() */
+    std::unordered_map<std::string, unsigned> m_platformIndices; /*!< Platform serial number to index */
+    bool m_computeDerived; /*!< true if the derived quantities are computed and stored after the raw channels */
+    unsigned m_ringChannels; /*!< Number of values stored for each sample */
+    double m_contactThreshold; /*!< Vertical force above which a platform is in contact (N) */
+    std::vector<PlateGeometry> m_geometry; /*!< Geometry of each platform */
+    std::vector<double> m_derived; /*!< derived quantities of one dataset of all the platforms, only accessed by the reader thread */
+    std::vector<double> m_sample; /*!< sample being pushed, only accessed by the reader thread */
+
+    void ingestPacket(double arrivalTime);
+    void computeDerivedQuantities(const double *dataset);
+    void readAvailablePackets(double timeout);
+
+    //private classes for reading from the sensor
     class AMTIReaderThread;
-    AMTIReaderThread *m_reader; /*!< internal thread which reads data from the platform */
+    class AMTINotifiedReaderThread;
+    AMTIReaderThread *m_reader; /*!< internal thread which reads data from the platform every period (poll mode) */
+    AMTINotifiedReaderThread *m_notifiedReader; /*!< internal thread which reads data when notified by the driver (callback mode) */
 
-    int m_status; /*!< status of the driver */
+    std::atomic<int> m_status; /*!< status of the driver */
 
 public:
     AMTIPlatformsDriver();
@@ -59,9 +112,21 @@ public:
     //IMultipleForcePlates interface
     virtual int getNumberOfPlatforms();
     virtual int getPlatformIndexForPlatformID(const std::string& platformID);
+    virtual unsigned getNumberOfChannels();
     virtual int getLastMeasurementForPlateAtIndex(const unsigned platformIndex,
         yarp::sig::Vector& measurement,
         yarp::os::Stamp *timestamp);
+    virtual int getNewSamples(ForcePlatesCursor& cursor,
+        unsigned maxSamples,
+        double *samples,
+        double *timestamps,
+        unsigned *sampleCount,
+        uint64_t *lostSamples);
+
+    virtual bool getLastSyncEdge(const unsigned platformIndex, double& edgeTime, uint64_t& sequence);
+
+    //IForcePlatesMetadata interface
+    virtual bool getPlatformInfo(const unsigned platformIndex, ForcePlateInfo& info);
 
     // IPreciselyTimed interface
     virtual yarp::os::Stamp getLastInputStamp();
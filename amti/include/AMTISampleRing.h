@@ -0,0 +1,136 @@
+/*
+* Copyright (C) 2016 iCub Facility
+* Authors: Francesco Romano
+* CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+*/
+
+#ifndef AMTISAMPLERING_H
+#define AMTISAMPLERING_H
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+/**
+ * Fixed capacity ring of timestamped samples of one force plate.
+ *
+ * Samples are numbered with a monotonic sequence number starting from 1,
+ * so that a reader can keep a cursor (the sequence of the last sample it consumed)
+ * and know how many samples have been overwritten before it could read them.
+ *
+ * The ring has a single writer and any number of readers, which never block the writer:
+ * every slot is protected by a seqlock (the sequence number of the sample it contains,
+ * 0 while it is being written) and a reader retries or skips a slot overwritten during the copy.
+ * resize() must not be called concurrently with the other methods.
+ */
+class AMTISampleRing
+{
+public:
+    AMTISampleRing()
+        : m_capacity(0)
+        , m_channels(0)
+        , m_lastSequence(0) {}
+
+    /**
+     * Allocate the ring and discard its content
+     * @param capacity number of samples kept
+     * @param channels number of values of each sample
+     */
+    void resize(unsigned capacity, unsigned channels)
+    {
+        m_capacity = capacity;
+        m_channels = channels;
+        m_samples.assign(static_cast<size_t>(capacity) * channels, 0.0);
+        m_timestamps.assign(capacity, 0.0);
+        m_slotSequences.reset(new std::atomic<uint64_t>[capacity]);
+        for (unsigned i = 0; i < capacity; ++i) {
+            m_slotSequences[i].store(0, std::memory_order_relaxed);
+        }
+        m_lastSequence.store(0, std::memory_order_release);
+    }
+
+    unsigned capacity() const { return m_capacity; }
+    unsigned channels() const { return m_channels; }
+
+    /**
+     * Sequence number of the last sample pushed, 0 if the ring is empty
+     */
+    uint64_t lastSequence() const { return m_lastSequence.load(std::memory_order_acquire); }
+
+    /**
+     * Sequence number of the oldest sample still in the ring
+     */
+    uint64_t firstSequence() const
+    {
+        uint64_t last = lastSequence();
+        return last > m_capacity ? last - m_capacity + 1 : 1;
+    }
+
+    /**
+     * Append a sample, overwriting the oldest one if the ring is full. Only one thread may push.
+     * @param sample m_channels values
+     * @param timestamp time of the sample
+     */
+    void push(const double *sample, double timestamp)
+    {
+        uint64_t sequence = m_lastSequence.load(std::memory_order_relaxed) + 1;
+        size_t slot = static_cast<size_t>((sequence - 1) % m_capacity);
+
+        m_slotSequences[slot].store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::copy(sample, sample + m_channels, m_samples.begin() + slot * m_channels);
+        m_timestamps[slot] = timestamp;
+        m_slotSequences[slot].store(sequence, std::memory_order_release);
+
+        m_lastSequence.store(sequence, std::memory_order_release);
+    }
+
+    /**
+     * Copy the sample with the specified sequence number
+     * @param[in] sequence sequence number of the sample
+     * @param[out] sample buffer of channels() values
+     * @param[out] timestamp time of the sample
+     * @return false if the sample has not been pushed yet or has been overwritten
+     */
+    bool read(uint64_t sequence, double *sample, double &timestamp) const
+    {
+        if (sequence == 0 || m_capacity == 0) {
+            return false;
+        }
+        size_t slot = static_cast<size_t>((sequence - 1) % m_capacity);
+        if (m_slotSequences[slot].load(std::memory_order_acquire) != sequence) {
+            return false;
+        }
+        std::copy(m_samples.begin() + slot * m_channels, m_samples.begin() + (slot + 1) * m_channels, sample);
+        timestamp = m_timestamps[slot];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_slotSequences[slot].load(std::memory_order_relaxed) == sequence;
+    }
+
+    /**
+     * Copy the newest sample
+     * @return the sequence number of the sample, 0 if the ring is empty
+     */
+    uint64_t readLatest(double *sample, double &timestamp) const
+    {
+        while (true) {
+            uint64_t sequence = lastSequence();
+            if (sequence == 0 || read(sequence, sample, timestamp)) {
+                return sequence;
+            }
+            // overwritten while copying (the writer lapped the ring): take the new latest
+        }
+    }
+
+private:
+    unsigned m_capacity;
+    unsigned m_channels;
+    std::vector<double> m_samples;
+    std::vector<double> m_timestamps;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_slotSequences; /*!< sequence of the sample in each slot, 0 while writing */
+    std::atomic<uint64_t> m_lastSequence;
+};
+
+#endif // AMTISAMPLERING_H
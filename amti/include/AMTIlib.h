@@ -11,6 +11,9 @@
 extern "C" {
 #endif  /* __cplusplus */
 
+	/** Number of datasets contained in each data block transferred by the AMTI driver */
+#define AMTI_DATASETS_PER_PACKET 16
+
 	typedef enum AMTI_CONFIGURATION_CHECK
 	{
 		AMTI_CONFIGURATION_CHECK_NODEVICES = 0,
@@ -182,15 +185,35 @@ extern "C" {
     /**
     * Get the actual measurement from all the force plates in the system
     *
-    * @note all the 16 measurements are returned
+    * @note all the 16 measurements are returned, from the oldest to the newest.
+    * Each dataset contains channelSize values for each platform, in platform order.
     *
     * @param[in] numOfPlatforms number of force plates in the system
     * @param[in] channelSize 6 or 8 depending on the dataFormat chosen
-    * @param[out] reading already allocated vector of size 16 * channelSize * numOfPlatforms containing 16 measurements
+    * @param[out] reading already allocated vector of size AMTI_DATASETS_PER_PACKET * channelSize * numOfPlatforms containing 16 measurements
     * @return 0 if no measurements are available, > 0 if at least one measure is available.
     */
     int getLastDataPacket(unsigned numOfPlatforms, unsigned channelSize, double* reading);
 
+    /**
+     * Returns the identifier of the calling thread, to be passed to configureDriverRunMode
+     * to receive the data-ready notifications of the AMTI_RUNMODE_CALLBACK mode.
+     * It also prepares the calling thread to receive them.
+     * @return the identifier of the calling thread
+     */
+    unsigned int getCurrentThreadIdentifier();
+
+    /**
+     * Waits for a data-ready notification of the AMTI_RUNMODE_CALLBACK mode.
+     * It must be called from the thread configured with configureDriverRunMode.
+     *
+     * @note notifications are not counted: after a successful wait, all the
+     * available blocks should be transferred with getLastDataPacket
+     * @param timeoutInMilliseconds maximum time to wait
+     * @return 1 if a notification has been received, 0 on timeout
+     */
+    int waitForDataReady(unsigned timeoutInMilliseconds);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,55 @@
+/*
+* Copyright (C) 2016 iCub Facility
+* Authors: Francesco Romano
+* CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+*/
+
+#ifndef IFORCEPLATESMETADATA_H
+#define IFORCEPLATESMETADATA_H
+
+#include <string>
+
+namespace yarp {
+namespace dev {
+    class IForcePlatesMetadata;
+    struct ForcePlateInfo;
+}
+}
+
+/**
+ * Static description of a force plate amplifier
+ */
+struct yarp::dev::ForcePlateInfo
+{
+    std::string modelNumber;      /*!< amplifier model number */
+    std::string serialNumber;     /*!< amplifier serial number, used as platform ID */
+    std::string firmwareVersion;  /*!< amplifier firmware version */
+    std::string calibrationDate;  /*!< date of the last calibration of the amplifier */
+    int acquisitionRate;          /*!< acquisition rate (Hz) */
+};
+
+/**
+ * Access to the inventory of the force plates handled by a device.
+ * The inventory is captured when the device is opened and does not change afterwards,
+ * so the methods never wait for the hardware.
+ */
+class yarp::dev::IForcePlatesMetadata
+{
+public:
+
+    /**
+     * Virtual destructor
+     */
+    virtual ~IForcePlatesMetadata();
+
+    /**
+     * Get the description of the platform at the specified index
+     * @param[in] platformIndex index of the platform
+     * @param[out] info the description of the platform
+     * @return false if the index is not valid
+     */
+    virtual bool getPlatformInfo(const unsigned platformIndex, ForcePlateInfo& info) = 0;
+
+};
+
+#endif // IFORCEPLATESMETADATA_H
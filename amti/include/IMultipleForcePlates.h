@@ -8,15 +8,28 @@
 #define IMULTIPLEFORCEPLATES_H
 
 #include <string>
+#include <vector>
+#include <stdint.h>
 #include <yarp/sig/Vector.h>
 #include <yarp/os/Stamp.h>
 
 namespace yarp {
 namespace dev {
     class IMultipleForcePlates;
+    struct ForcePlatesCursor;
 }
 }
 
+/**
+ * Position of a reader in the sample stream of every platform.
+ * It is owned by the caller and updated by IMultipleForcePlates::getNewSamples.
+ * A default constructed (empty) cursor starts from the oldest sample still buffered.
+ */
+struct yarp::dev::ForcePlatesCursor
+{
+    std::vector<uint64_t> lastSequence; /*!< sequence number of the last sample read, for each platform */
+};
+
 class yarp::dev::IMultipleForcePlates
 {
 public:
@@ -39,11 +52,35 @@ public:
      */
     virtual int getPlatformIndexForPlatformID(const std::string& platformID) = 0;
 
+    /**
+     * Channels following the forces and moments when the device computes the derived quantities
+     * (see getNumberOfChannels). The center of pressure and the free moment are expressed in the
+     * platform frame, the combined center of pressure of all the platforms in a frame common to them.
+     * Without contact the center of pressure and the free moment are 0.
+     */
+    enum DerivedChannel {
+        CHANNEL_COP_X = 6,          /*!< center of pressure x (m) */
+        CHANNEL_COP_Y,              /*!< center of pressure y (m) */
+        CHANNEL_FREE_MOMENT,        /*!< moment about the vertical axis through the center of pressure (Nm) */
+        CHANNEL_CONTACT,            /*!< 1 if the vertical force exceeds the contact threshold, 0 otherwise */
+        CHANNEL_COMBINED_COP_X,     /*!< center of pressure of all the platforms in contact, x (m) */
+        CHANNEL_COMBINED_COP_Y,     /*!< center of pressure of all the platforms in contact, y (m) */
+        CHANNELS_WITH_DERIVED       /*!< number of channels when the derived quantities are computed */
+    };
+
+    /**
+     * Returns the number of values of each measure: SAMPLE_CHANNELS (forces and moments),
+     * or CHANNELS_WITH_DERIVED if the device also computes the derived quantities
+     * @return the number of channels of each platform
+     */
+    virtual unsigned getNumberOfChannels();
+
     /**
      * Get the last measure read by the platform at the specified index
      *
      * @param[in] platformIndex index of the platform
-     * @param[out] measurement vector filled with the last measurements of the force plate
+     * @param[out] measurement vector filled with the last measurements of the force plate.
+     *             Only the first measurement.size() channels (at most getNumberOfChannels()) are filled
      * @param[out] timestamp timestamp associated with the last measure. Pass NULL if not interested in the timestamp
      * @return the status of the measure as in yarp::dev::IAnalogSensor
      */
@@ -51,6 +88,53 @@ public:
                                                    yarp::sig::Vector& measurement,
                                                    yarp::os::Stamp *timestamp) = 0;
 
+    /**
+     * Get the last edge of the sync (genlock) input seen by the platform at the specified index
+     *
+     * The edge time is the timestamp of the first sample acquired after the edge: streams of other
+     * devices sharing the same sync signal can be aligned on it.
+     * The default implementation returns false.
+     *
+     * @param[in] platformIndex index of the platform
+     * @param[out] edgeTime time of the edge, in the same clock of the timestamps of the samples
+     * @param[out] sequence sequence number (as in the timestamps) of the first sample after the edge
+     * @return true if an edge has been seen
+     */
+    virtual bool getLastSyncEdge(const unsigned platformIndex, double& edgeTime, uint64_t& sequence);
+
+    /**
+     * Number of values of the forces and moments of each sample
+     */
+    static const unsigned SAMPLE_CHANNELS = 6;
+
+    /**
+     * Get, for all the platforms in a single call, every sample received after the cursor
+     *
+     * Samples are written platform by platform, from the oldest to the newest.
+     * Each sample has C = getNumberOfChannels() values:
+     * sample s of platform p starts at samples[(p * maxSamples + s) * C]
+     * and its time is timestamps[p * maxSamples + s].
+     * If more than maxSamples samples are available, the oldest ones are returned and the remaining
+     * ones are left for the next call.
+     *
+     * The default implementation returns only the last measurement of each platform, if it is new.
+     *
+     * @param[in,out] cursor position of the caller in the stream, updated upon return
+     * @param[in] maxSamples maximum number of samples per platform
+     * @param[out] samples buffer of getNumberOfPlatforms() * maxSamples * getNumberOfChannels() values
+     * @param[out] timestamps buffer of getNumberOfPlatforms() * maxSamples values. Pass NULL if not interested
+     * @param[out] sampleCount buffer of getNumberOfPlatforms() values, filled with the number of samples returned
+     * @param[out] lostSamples buffer of getNumberOfPlatforms() values, filled with the number of samples overwritten
+     *             before they could be read. Pass NULL if not interested
+     * @return the status of the measures as in yarp::dev::IAnalogSensor
+     */
+    virtual int getNewSamples(ForcePlatesCursor& cursor,
+                              unsigned maxSamples,
+                              double *samples,
+                              double *timestamps,
+                              unsigned *sampleCount,
+                              uint64_t *lostSamples);
+
 };
 
 #endif // IMULTIPLEFORCEPLATES_H
@@ -8,9 +8,10 @@
 
 #include "IMultipleForcePlates.h"
 #include <yarp/os/LogStream.h>
+#include <yarp/os/Bottle.h>
 #include <yarp/sig/Vector.h>
-#include <yarp/math/Math.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -22,7 +23,14 @@ yarp::dev::AMTIForcePlate::AMTIForcePlate()
     , m_status(AS_ERROR)
     , m_platformDriver(0)
     , m_platformIndex(-1)
-{}
+{
+    for (int r = 0; r < 6; ++r) {
+        for (int c = 0; c < 6; ++c) {
+            m_wrenchTransform[r][c] = r == c ? 1 : 0;
+        }
+    }
+    std::fill(m_position, m_position + 3, 0.0);
+}
 yarp::dev::AMTIForcePlate::~AMTIForcePlate()
 {}
 
@@ -43,30 +51,72 @@ bool yarp::dev::AMTIForcePlate::open(yarp::os::Searchable &config)
     yInfo() << "Platform with ID " << m_platformID << " found";
 
 
-    // Get platform rotation
-    m_rotation_angle = 0.0;
-    yarp::sig::Matrix m_transform;
-    m_transform.zero();
-
-    // Only z-axis rotation is considered as a configuration parameter
+    // Get platform pose
     // Reference: Check fmSetPlatformRotation() from http://www.amti.jp/Gen%205%20Programmers%20Reference.pdf
-    if (!config.check("platformZRotation") )
-    {
-        yInfo("<platformZRotation> configuration parameter is not passed. Using default rotation 0 degree about z-axis for platform %s", m_platformID);
+    // The rotation is given as roll, pitch, yaw (degrees, R = Rz(yaw) * Ry(pitch) * Rx(roll)).
+    // platformZRotation is kept for backward compatibility and gives the yaw only.
+    double rpy[3] = {0, 0, 0};
+    double position[3] = {0, 0, 0};
+
+    if (config.check("platformRotation")) {
+        yarp::os::Bottle *rotation = config.find("platformRotation").asList();
+        if (!rotation || rotation->size() != 3) {
+            yError("platformRotation must be a list of 3 angles (roll pitch yaw) in degrees");
+            return false;
+        }
+        for (int i = 0; i < 3; ++i) {
+            rpy[i] = rotation->get(i).asFloat64();
+        }
     }
-    else
-    {
-        m_rotation_angle = config.find("platformZRotation").asFloat64();
-        yInfo("Using platform rotation of %f degree about z-axis for platform %s", m_rotation_angle, m_platformID);
+    else if (config.check("platformZRotation")) {
+        rpy[2] = config.find("platformZRotation").asFloat64();
+    }
+    else {
+        yInfo("Neither <platformRotation> nor <platformZRotation> configuration parameter is passed. Using no rotation for platform %s", m_platformID.c_str());
     }
 
-    // Set transform with rotation
-    yarp::sig::Vector rotz = {0, 0, (m_rotation_angle / 180) * M_PI};
-
-    yarp::sig::Matrix transform = yarp::math::euler2dcm(rotz);
-    yarp::sig::Matrix adjInv = yarp::math::adjointInv(transform);
-    m_transform_wrench.zero();
-    m_transform_wrench = adjInv.transposed();
+    if (config.check("platformPosition")) {
+        yarp::os::Bottle *origin = config.find("platformPosition").asList();
+        if (!origin || origin->size() != 3) {
+            yError("platformPosition must be a list of 3 coordinates in meters");
+            return false;
+        }
+        for (int i = 0; i < 3; ++i) {
+            position[i] = origin->get(i).asFloat64();
+        }
+    }
+    yInfo("Platform %s: rotation (rpy) %f %f %f degrees, position %f %f %f m", m_platformID.c_str(),
+          rpy[0], rpy[1], rpy[2], position[0], position[1], position[2]);
+
+    const double cr = std::cos(rpy[0] / 180 * M_PI), sr = std::sin(rpy[0] / 180 * M_PI);
+    const double cp = std::cos(rpy[1] / 180 * M_PI), sp = std::sin(rpy[1] / 180 * M_PI);
+    const double cy = std::cos(rpy[2] / 180 * M_PI), sy = std::sin(rpy[2] / 180 * M_PI);
+    const double rotation[3][3] = {
+        {cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+        {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+        {-sp,     cp * sr,                cp * cr}
+    };
+    // skew symmetric matrix of the position, i.e. the cross product p x .
+    const double skew[3][3] = {
+        {0,            -position[2], position[1]},
+        {position[2],  0,            -position[0]},
+        {-position[1], position[0],  0}
+    };
+
+    // Wrench in world frame: f = R f_p, m = R m_p + p x (R f_p)
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            double skewRotation = 0;
+            for (int k = 0; k < 3; ++k) {
+                skewRotation += skew[r][k] * rotation[k][c];
+            }
+            m_wrenchTransform[r][c] = rotation[r][c];
+            m_wrenchTransform[r][c + 3] = 0;
+            m_wrenchTransform[r + 3][c] = skewRotation;
+            m_wrenchTransform[r + 3][c + 3] = rotation[r][c];
+        }
+    }
+    std::copy(position, position + 3, m_position);
 
     return true;
 
@@ -86,14 +136,41 @@ int yarp::dev::AMTIForcePlate::read(yarp::sig::Vector &out)
     m_status = m_platformDriver->getLastMeasurementForPlateAtIndex(m_platformIndex,
                                                                    m_sensorReadings,
                                                                    &m_timestamp);
-    // Transform wrench measurements
-    out = m_transform_wrench * m_sensorReadings;
+    // Transform wrench measurements (no allocation once out has the right size).
+    // The derived quantities computed by the platforms driver, if any, follow them
+    out.resize(m_sensorReadings.size());
+    transformWrenches(m_sensorReadings.data(), out.data(), 1);
+    std::copy(m_sensorReadings.begin() + 6, m_sensorReadings.end(), out.begin() + 6);
+    if (out.size() > IMultipleForcePlates::CHANNEL_CONTACT && out[IMultipleForcePlates::CHANNEL_CONTACT] != 0) {
+        // same pose as the wrench: the rotation is the upper left block of the wrench transform
+        const double x = m_sensorReadings[IMultipleForcePlates::CHANNEL_COP_X];
+        const double y = m_sensorReadings[IMultipleForcePlates::CHANNEL_COP_Y];
+        out[IMultipleForcePlates::CHANNEL_COP_X] = m_wrenchTransform[0][0] * x + m_wrenchTransform[0][1] * y + m_position[0];
+        out[IMultipleForcePlates::CHANNEL_COP_Y] = m_wrenchTransform[1][0] * x + m_wrenchTransform[1][1] * y + m_position[1];
+        out[IMultipleForcePlates::CHANNEL_FREE_MOMENT] = m_wrenchTransform[2][2] * m_sensorReadings[IMultipleForcePlates::CHANNEL_FREE_MOMENT];
+    }
     return m_status;
 
 }
 
+void yarp::dev::AMTIForcePlate::transformWrenches(const double *wrenches, double *transformed, unsigned count) const
+{
+    for (unsigned sample = 0; sample < count; ++sample) {
+        double wrench[6];
+        std::copy(wrenches + sample * 6, wrenches + (sample + 1) * 6, wrench);
+        double *output = transformed + sample * 6;
+        for (int r = 0; r < 6; ++r) {
+            double value = 0;
+            for (int c = 0; c < 6; ++c) {
+                value += m_wrenchTransform[r][c] * wrench[c];
+            }
+            output[r] = value;
+        }
+    }
+}
+
 int yarp::dev::AMTIForcePlate::getState(int ch) { return m_status; }
-int yarp::dev::AMTIForcePlate::getChannels() { return m_status == AS_OK ? 6 : 0;  }
+int yarp::dev::AMTIForcePlate::getChannels() { return m_status == AS_OK ? static_cast<int>(m_sensorReadings.size()) : 0;  }
 int yarp::dev::AMTIForcePlate::calibrateSensor() { return m_status;  }
 int yarp::dev::AMTIForcePlate::calibrateSensor(const yarp::sig::Vector &value) { return m_status; }
 int yarp::dev::AMTIForcePlate::calibrateChannel(int ch) { return m_status; }
@@ -114,6 +191,8 @@ bool yarp::dev::AMTIForcePlate::attach(yarp::dev::PolyDriver *poly)
     if (!poly->view(m_platformDriver) || !m_platformDriver) return false;
     m_platformIndex = m_platformDriver->getPlatformIndexForPlatformID(m_platformID);
     yInfo("Platform with ID %s associated to index %d", m_platformID.c_str(), m_platformIndex);
+    m_sensorReadings.resize(m_platformDriver->getNumberOfChannels());
+    m_sensorReadings.zero();
 
     m_status = m_platformIndex >= 0 ? AS_OK : AS_ERROR;
     return m_platformIndex >= 0;
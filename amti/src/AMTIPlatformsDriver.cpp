@@ -10,9 +10,13 @@
 
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 
 #include <yarp/os/LogStream.h>
+#include <yarp/os/Bottle.h>
 #include <yarp/os/PeriodicThread.h>
+#include <yarp/os/Thread.h>
 #include <yarp/os/Time.h>
 #include <yarp/dev/IAnalogSensor.h>
 
@@ -27,36 +31,59 @@ public:
 
     virtual void run()
     {
-        std::lock_guard<std::mutex> guard(driver.m_mutex);
+        driver.readAvailablePackets(timeout);
+    }
 
-        //keeping only the last reading
-        while (getCurrentData(driver.m_numOfPlatforms, driver.m_channelSize, driver.m_sensorReadings.data()))
-        {
-            driver.m_timestamp.update();
-        }
+};
 
-        if (std::abs(yarp::os::Time::now() - driver.m_timestamp.getTime()) > timeout) {
-            //timeout error
-            driver.m_status = yarp::dev::IAnalogSensor::AS_TIMEOUT;
-        }
-        else if (driver.m_status != yarp::dev::IAnalogSensor::AS_ERROR) {
-            //reset the status to be OK
-            driver.m_status = yarp::dev::IAnalogSensor::AS_OK;
-        }
+// Reader woken up by the data-ready notifications of the AMTI driver (callback run mode)
+class yarp::dev::AMTIPlatformsDriver::AMTINotifiedReaderThread : public yarp::os::Thread
+{
+    yarp::dev::AMTIPlatformsDriver &driver;
+    double timeout;
+
+public:
+    AMTINotifiedReaderThread(yarp::dev::AMTIPlatformsDriver& _driver, double _timeout)
+        : driver(_driver), timeout(_timeout) {}
 
+    virtual bool threadInit()
+    {
+        // notifications are delivered to the thread registered in the driver
+        std::lock_guard<std::mutex> sdkGuard(driver.m_sdkMutex);
+        configureDriverRunMode(AMTI_RUNMODE_CALLBACK, getCurrentThreadIdentifier());
+        return true;
+    }
+
+    virtual void run()
+    {
+        // the wait is bounded to check for the timeout and for stop requests
+        unsigned waitInMilliseconds = static_cast<unsigned>(std::max(1.0, std::min(timeout, 0.1) * 1000));
+        while (!isStopping()) {
+            waitForDataReady(waitInMilliseconds);
+            driver.readAvailablePackets(timeout);
+        }
     }
 
 };
 
 
 yarp::dev::AMTIPlatformsDriver::AMTIPlatformsDriver()
-    : m_sensorReadings(6)
+    : m_numOfPlatforms(0)
+    , m_channelSize(6)
+    , m_samplePeriod(0)
+    , m_clockWindow(2)
+    , m_syncOnFallingEdge(false)
+    , m_triggerThreshold(0)
+    , m_computeDerived(false)
+    , m_ringChannels(6)
+    , m_contactThreshold(0)
     , m_reader(0)
+    , m_notifiedReader(0)
     , m_status(yarp::dev::IAnalogSensor::AS_ERROR)
 {
 
-    m_sensorReadings.zero();
-    m_timestamp.update();
+    m_lastPacketTime = yarp::os::Time::now();
+    m_packetCount = 0;
 
 }
 
@@ -117,27 +144,43 @@ bool yarp::dev::AMTIPlatformsDriver::open(yarp::os::Searchable &config)
     }
     configureDriverDataFormat(dataFormat);
 
+    std::string runMode = config.check("runMode", yarp::os::Value("poll"), "acquisition mode (poll: read every period|callback: read when the driver notifies new data)").asString();
+    bool notified = runMode == "callback";
+    if (!notified && runMode != "poll") {
+        yError("Run mode option not recognized. Only (poll|callback) are allowed");
+        return false;
+    }
+    // in callback mode the reader thread registers itself for the notifications when started
     configureDriverRunMode(AMTI_RUNMODE_POLL);
 
     // Get the number of platforms and their order
     // for now this info is only printed, but it should be used to order the output data
     m_numOfPlatforms = getPlatformsCount();
 
-    //Platform returns data packed in 16 datasets.
-    //While for batch analysis this makes completely sense,
-    //For real-time acquisition this means that the platform
-    //rate is 16 times slower
-    
-    //first, convert the period in Hertz
-    double rateInHertz = 1.0 / ((double)periodInMilliseconds / 1000.0);
-    //then multiply by 16
-    rateInHertz *= 16;
-    //get the next integer
-    int desiredPlatformRate = std::ceil(rateInHertz);
-
-    int *availableRates; unsigned numOfAvailableRates;
+    //Platform returns data packed in 16 datasets, all of them are stored.
+    //If the acquisition rate is not specified, it is chosen
+    //to receive (at least) one block per thread period
+    int desiredPlatformRate = 0;
+    if (config.check("acquisitionRate")) {
+        desiredPlatformRate = config.find("acquisitionRate").asInt32();
+        if (desiredPlatformRate <= 0) {
+            yError("acquisitionRate must be positive");
+            return false;
+        }
+    }
+    else {
+        //first, convert the period in Hertz
+        double rateInHertz = 1.0 / ((double)periodInMilliseconds / 1000.0);
+        //then multiply by 16
+        rateInHertz *= AMTI_DATASETS_PER_PACKET;
+        //get the next integer
+        desiredPlatformRate = std::ceil(rateInHertz);
+    }
+
+    int *availableRates = nullptr; unsigned numOfAvailableRates = 0;
     getAvailableAcquisitionRates(availableRates, numOfAvailableRates);
     if (numOfAvailableRates == 0) {
+        delete[] availableRates;
         yError("Error while retrieving possible rates");
         return false;
     }
@@ -154,9 +197,13 @@ bool yarp::dev::AMTIPlatformsDriver::open(yarp::os::Searchable &config)
         }
     }
     
-    setAcquisitionRate(availableRates[acquisitionRateIndex]);
+    int chosenRate = availableRates[acquisitionRateIndex];
     delete[] availableRates;
+    setAcquisitionRate(chosenRate);
 
+    // The inventory is read once: looking up a platform later must not touch the SDK
+    m_inventory.clear();
+    m_platformIndices.clear();
     for (unsigned i = 0; i < m_numOfPlatforms; ++i) {
         char platformModelNumber[16];
         char platformSerialNumber[16];
@@ -171,20 +218,113 @@ bool yarp::dev::AMTIPlatformsDriver::open(yarp::os::Searchable &config)
             platformFwVersion, calibrationDate);
         int rate = getAcquisitionRate(i);
         yInfo("Platform %d - Acquisition rate %d Hz", i, rate);
+
+        ForcePlateInfo info;
+        info.modelNumber = platformModelNumber;
+        info.serialNumber = platformSerialNumber;
+        info.firmwareVersion = platformFwVersion;
+        info.calibrationDate = calibrationDate;
+        info.acquisitionRate = rate;
+        m_inventory.push_back(info);
+        if (!m_platformIndices.insert(std::make_pair(info.serialNumber, i)).second) {
+            yWarning("Platform serial number %s is not unique: only the first one can be looked up", platformSerialNumber);
+        }
+    }
+    int acquisitionRate = m_numOfPlatforms > 0 ? m_inventory[0].acquisitionRate : chosenRate;
+    if (acquisitionRate <= 0) {
+        yError("Invalid acquisition rate %d", acquisitionRate);
+        return false;
     }
-    m_sensorReadings.resize(m_channelSize * m_numOfPlatforms);
-    m_sensorReadings.zero();
+    m_samplePeriod = 1.0 / acquisitionRate;
+    double blockPeriod = AMTI_DATASETS_PER_PACKET * m_samplePeriod;
+    double readerPeriod = notified ? 0 : periodInMilliseconds / 1000.0;
+    if (readerPeriod > blockPeriod) {
+        yWarning("Thread period (%d ms) longer than the data block period (%f s): blocks will be read in bursts", periodInMilliseconds, blockPeriod);
+    }
+
+    // Timestamps: the sample counter (local if not in the extended format) is mapped to the local clock,
+    // estimated from the arrival of the last blocks
+    double clockWindow = config.check("clockWindow", yarp::os::Value(2.0), "time span of the data blocks used to estimate the amplifier clock (s)").asFloat64();
+    m_clockWindow = static_cast<unsigned>(std::max(2.0, std::ceil(clockWindow / blockPeriod)));
+    // Sync edges are read from the trigger channel of the extended format, and anchor the timestamps
+    m_syncOnFallingEdge = genlockOption == AMTI_GENLOCK_EDGE_FALLING;
+    m_triggerThreshold = config.check("triggerThreshold", yarp::os::Value(0.5), "value of the trigger channel above which the sync input is active").asFloat64();
+    if (genlockOption != AMTI_GENLOCK_OFF && dataFormat != AMTI_DATAFORMAT_EXTENDED) {
+        yWarning("genlock is enabled but sync edges are only detected with dataFormat ext");
+    }
+
+    // Derived quantities: the geometry of each platform is read from the group named as its serial number
+    m_computeDerived = config.check("derivedQuantities", yarp::os::Value(false), "compute center of pressure, free moment and contact of each sample").asBool();
+    m_contactThreshold = config.check("contactThreshold", yarp::os::Value(20.0), "vertical force above which a platform is in contact (N)").asFloat64();
+    m_geometry.assign(m_numOfPlatforms, PlateGeometry());
+    for (unsigned i = 0; i < m_numOfPlatforms; ++i) {
+        PlateGeometry &geometry = m_geometry[i];
+        yarp::os::Searchable &group = config.findGroup(m_inventory[i].serialNumber);
+        geometry.surfaceHeight = group.check("surfaceHeight", yarp::os::Value(0.0), "z of the plate surface in the platform frame (m)").asFloat64();
+        geometry.position[0] = geometry.position[1] = 0;
+        if (group.check("position")) {
+            yarp::os::Bottle *position = group.find("position").asList();
+            if (!position || position->size() != 2) {
+                yError("position of platform %s must be a list of 2 coordinates (m)", m_inventory[i].serialNumber.c_str());
+                return false;
+            }
+            geometry.position[0] = position->get(0).asFloat64();
+            geometry.position[1] = position->get(1).asFloat64();
+        }
+        double yaw = group.check("yaw", yarp::os::Value(0.0), "rotation of the platform about the vertical axis of the common frame (deg)").asFloat64() / 180 * M_PI;
+        geometry.cosYaw = std::cos(yaw);
+        geometry.sinYaw = std::sin(yaw);
+    }
+    m_ringChannels = m_channelSize + (m_computeDerived ? CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS : 0);
+    m_derived.assign(m_numOfPlatforms * (CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS), 0.0);
+    m_sample.assign(m_ringChannels, 0.0);
 
-    calibratePlatforms();
+    int bufferSize = config.check("bufferSize", yarp::os::Value(std::max(acquisitionRate, 4 * AMTI_DATASETS_PER_PACKET)), "number of samples buffered for each platform").asInt32();
+    if (bufferSize < AMTI_DATASETS_PER_PACKET) {
+        yError("bufferSize must be at least %d", AMTI_DATASETS_PER_PACKET);
+        return false;
+    }
+    m_platforms.reset(new PlatformBuffer[m_numOfPlatforms]);
+    for (unsigned i = 0; i < m_numOfPlatforms; ++i) {
+        m_platforms[i].ring.resize(bufferSize, m_ringChannels);
+        m_platforms[i].clock.reset(m_samplePeriod, m_clockWindow);
+        m_platforms[i].firstCounter = 0;
+        m_platforms[i].lastCounter = 0;
+        m_platforms[i].triggerActive = false;
+        m_platforms[i].lastSyncEdge = 0;
+    }
+    m_packet.assign(AMTI_DATASETS_PER_PACKET * m_channelSize * m_numOfPlatforms, 0.0);
+
+    {
+        // the reader thread is not running yet, but every SDK call is serialized
+        std::lock_guard<std::mutex> sdkGuard(m_sdkMutex);
+        calibratePlatforms();
+        startAcquisition();
+    }
 
     //create the reader
-    m_reader = new AMTIReaderThread(*this, periodInMilliseconds, readingTimeout);
-    if (m_reader && m_reader->start()) {
+    bool started = false;
+    if (notified) {
+        m_notifiedReader = new AMTINotifiedReaderThread(*this, readingTimeout);
+        started = m_notifiedReader->start();
+    }
+    else {
+        m_reader = new AMTIReaderThread(*this, periodInMilliseconds, readingTimeout);
+        started = m_reader->start();
+    }
+    if (started) {
         m_status = yarp::dev::IAnalogSensor::AS_OK;
-        startAcquisition();
         return true;
     }
 
+    yError("Failed to start the reader thread");
+    delete m_reader;
+    m_reader = 0;
+    delete m_notifiedReader;
+    m_notifiedReader = 0;
+    std::lock_guard<std::mutex> sdkGuard(m_sdkMutex);
+    stopAcquisition();
+    releaseDriver();
     return false;
 }
 
@@ -198,7 +338,13 @@ bool yarp::dev::AMTIPlatformsDriver::close()
         delete m_reader;
         m_reader = 0;
     }
+    if (m_notifiedReader) {
+        m_notifiedReader->stop();
+        delete m_notifiedReader;
+        m_notifiedReader = 0;
+    }
 
+    std::lock_guard<std::mutex> sdkGuard(m_sdkMutex);
     stopAcquisition();
     releaseDriver();
 
@@ -217,50 +363,287 @@ yarp::dev::AMTIPlatformsDriver& yarp::dev::AMTIPlatformsDriver::operator=(const
     return *this;
 }
 
+void yarp::dev::AMTIPlatformsDriver::readAvailablePackets(double timeout)
+{
+    //every dataset of every block is stored in the platform buffers.
+    //Only the SDK calls are serialized, the buffers are published without locks
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> sdkGuard(m_sdkMutex);
+            if (!getLastDataPacket(m_numOfPlatforms, m_channelSize, m_packet.data())) {
+                break;
+            }
+        }
+        double now = yarp::os::Time::now();
+        ingestPacket(now);
+        m_lastPacketTime.store(now);
+        m_packetCount++;
+    }
+
+    if (std::abs(yarp::os::Time::now() - m_lastPacketTime.load()) > timeout) {
+        //timeout error
+        m_status = yarp::dev::IAnalogSensor::AS_TIMEOUT;
+    }
+    else if (m_status != yarp::dev::IAnalogSensor::AS_ERROR) {
+        //reset the status to be OK
+        m_status = yarp::dev::IAnalogSensor::AS_OK;
+    }
+}
+
+void yarp::dev::AMTIPlatformsDriver::ingestPacket(double arrivalTime)
+{
+    const unsigned datasetSize = m_channelSize * m_numOfPlatforms;
+    const unsigned lastDataset = AMTI_DATASETS_PER_PACKET - 1;
+    // The extended format provides the sample counter of the amplifier as first channel.
+    // Otherwise samples are assumed contiguous and counted locally.
+    const bool hasCounter = m_channelSize == 8;
+
+    for (unsigned platform = 0; platform < m_numOfPlatforms; ++platform) {
+        PlatformBuffer &buffer = m_platforms[platform];
+        const double *first = &m_packet[platform * m_channelSize];
+
+        uint64_t firstCounter = buffer.ring.lastSequence() + 1;
+        if (hasCounter) {
+            // The counter reaches us through a float: past 2^24 it is rounded, so the 64 bit counter is
+            // rebuilt from the increments between blocks and the received value is only trusted beyond its rounding
+            const double received = first[0];
+            const double rounding = std::max(1.0, received * std::numeric_limits<float>::epsilon());
+            const double expected = static_cast<double>(buffer.lastCounter + 1);
+            if (!buffer.clock.valid() || received + rounding < expected - AMTI_DATASETS_PER_PACKET) {
+                // first block, or a counter going far backwards: the amplifier has been restarted
+                buffer.clock.reset(m_samplePeriod, m_clockWindow);
+                firstCounter = static_cast<uint64_t>(std::max(0.0, received));
+            }
+            else if (received > expected + rounding) {
+                // samples lost by the amplifier
+                firstCounter = static_cast<uint64_t>(std::llround(received));
+            }
+            else {
+                firstCounter = buffer.lastCounter + 1;
+            }
+        }
+        uint64_t lastCounter = firstCounter + lastDataset;
+
+        buffer.clock.update(static_cast<double>(lastCounter), arrivalTime);
+        buffer.firstCounter = firstCounter;
+        buffer.lastCounter = lastCounter;
+    }
+
+    const unsigned derivedSize = CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS;
+    for (unsigned dataset = 0; dataset < AMTI_DATASETS_PER_PACKET; ++dataset) {
+        const double *values = &m_packet[dataset * datasetSize];
+        if (m_computeDerived) {
+            computeDerivedQuantities(values);
+        }
+        for (unsigned platform = 0; platform < m_numOfPlatforms; ++platform) {
+            PlatformBuffer &buffer = m_platforms[platform];
+            const double *sample = values + platform * m_channelSize;
+            // the datasets of a block are contiguous samples
+            const double counter = static_cast<double>(buffer.firstCounter + dataset);
+            bool syncEdge = false;
+            if (hasCounter) {
+                // the trigger channel follows the sync input: the first sample after an edge marks it
+                // and becomes the phase reference of the timestamps
+                bool active = sample[7] > m_triggerThreshold;
+                syncEdge = active != buffer.triggerActive && active != m_syncOnFallingEdge && buffer.ring.lastSequence() > 0;
+                buffer.triggerActive = active;
+                if (syncEdge) {
+                    buffer.clock.anchor(counter);
+                }
+            }
+            double timestamp = buffer.clock.timeOf(counter);
+            if (m_computeDerived) {
+                std::copy(sample, sample + m_channelSize, m_sample.begin());
+                std::copy(&m_derived[platform * derivedSize], &m_derived[(platform + 1) * derivedSize], m_sample.begin() + m_channelSize);
+                sample = m_sample.data();
+            }
+            buffer.ring.push(sample, timestamp);
+            if (syncEdge) {
+                buffer.lastSyncEdge.store(buffer.ring.lastSequence(), std::memory_order_release);
+            }
+        }
+    }
+}
+
+void yarp::dev::AMTIPlatformsDriver::computeDerivedQuantities(const double *dataset)
+{
+    // For a plate surface at z = h in the platform frame, the wrench is applied at (x, y, h) with a
+    // free moment Tz about the vertical axis: Mx = y Fz - h Fy, My = h Fx - x Fz, Mz = x Fy - y Fx + Tz
+    const unsigned derivedSize = CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS;
+    const unsigned offset = m_channelSize == 8 ? 1 : 0; //skip the counter
+    double totalForce = 0, combinedX = 0, combinedY = 0;
+
+    for (unsigned platform = 0; platform < m_numOfPlatforms; ++platform) {
+        const double *wrench = dataset + platform * m_channelSize + offset;
+        const PlateGeometry &geometry = m_geometry[platform];
+        double *derived = &m_derived[platform * derivedSize];
+        const double fx = wrench[0], fy = wrench[1], fz = wrench[2];
+        const double mx = wrench[3], my = wrench[4], mz = wrench[5];
+
+        const bool contact = std::abs(fz) > m_contactThreshold;
+        double x = 0, y = 0, freeMoment = 0;
+        if (contact) {
+            x = (geometry.surfaceHeight * fx - my) / fz;
+            y = (mx + geometry.surfaceHeight * fy) / fz;
+            freeMoment = mz - x * fy + y * fx;
+            // contribution to the combined center of pressure, in the common frame
+            const double weight = std::abs(fz);
+            totalForce += weight;
+            combinedX += weight * (geometry.position[0] + geometry.cosYaw * x - geometry.sinYaw * y);
+            combinedY += weight * (geometry.position[1] + geometry.sinYaw * x + geometry.cosYaw * y);
+        }
+        derived[CHANNEL_COP_X - SAMPLE_CHANNELS] = x;
+        derived[CHANNEL_COP_Y - SAMPLE_CHANNELS] = y;
+        derived[CHANNEL_FREE_MOMENT - SAMPLE_CHANNELS] = freeMoment;
+        derived[CHANNEL_CONTACT - SAMPLE_CHANNELS] = contact ? 1 : 0;
+    }
+
+    if (totalForce > 0) {
+        combinedX /= totalForce;
+        combinedY /= totalForce;
+    }
+    for (unsigned platform = 0; platform < m_numOfPlatforms; ++platform) {
+        double *derived = &m_derived[platform * derivedSize];
+        derived[CHANNEL_COMBINED_COP_X - SAMPLE_CHANNELS] = combinedX;
+        derived[CHANNEL_COMBINED_COP_Y - SAMPLE_CHANNELS] = combinedY;
+    }
+}
+
 int yarp::dev::AMTIPlatformsDriver::getNumberOfPlatforms()
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
     return m_numOfPlatforms;
 }
 
+unsigned yarp::dev::AMTIPlatformsDriver::getNumberOfChannels()
+{
+    return m_computeDerived ? static_cast<unsigned>(CHANNELS_WITH_DERIVED) : SAMPLE_CHANNELS;
+}
+
 int yarp::dev::AMTIPlatformsDriver::getPlatformIndexForPlatformID(const std::string& platformID)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    for (unsigned i = 0; i < m_numOfPlatforms; ++i) {
-        char platformSerialNumber[16];
-        getPlatformSerialNumber(i, platformSerialNumber);
-        if (platformID == std::string(platformSerialNumber))
-            return i;
+    std::unordered_map<std::string, unsigned>::const_iterator found = m_platformIndices.find(platformID);
+    return found == m_platformIndices.end() ? -1 : static_cast<int>(found->second);
+}
+
+bool yarp::dev::AMTIPlatformsDriver::getLastSyncEdge(const unsigned platformIndex, double& edgeTime, uint64_t& sequence)
+{
+    if (platformIndex >= m_numOfPlatforms) {
+        return false;
     }
-    return -1;
+    const AMTISampleRing &ring = m_platforms[platformIndex].ring;
+    uint64_t edge = m_platforms[platformIndex].lastSyncEdge.load(std::memory_order_acquire);
+    double sample[8 + CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS];
+    // the time of the edge is the timestamp of its sample, while it is still buffered
+    if (edge == 0 || !ring.read(edge, sample, edgeTime)) {
+        return false;
+    }
+    sequence = edge;
+    return true;
+}
 
+bool yarp::dev::AMTIPlatformsDriver::getPlatformInfo(const unsigned platformIndex, ForcePlateInfo& info)
+{
+    if (platformIndex >= m_inventory.size()) {
+        return false;
+    }
+    info = m_inventory[platformIndex];
+    return true;
 }
 
 int yarp::dev::AMTIPlatformsDriver::getLastMeasurementForPlateAtIndex(const unsigned platformIndex,
     yarp::sig::Vector& measurement,
     yarp::os::Stamp *timestamp)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
     if (platformIndex >= m_numOfPlatforms) {
         measurement.zero();
         yError("Platform index must be less than %d", m_numOfPlatforms);
         return yarp::dev::IAnalogSensor::AS_ERROR;
     }
 
-    unsigned startingIndex = platformIndex * m_channelSize;
-    if (m_channelSize == 8) startingIndex++; //skip the first element
+    double sample[8 + CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS];
+    double sampleTime = 0;
+    uint64_t sequence = m_platforms[platformIndex].ring.readLatest(sample, sampleTime);
+    if (sequence == 0) {
+        measurement.zero();
+        if (timestamp) {
+            *timestamp = getLastInputStamp();
+        }
+        return m_status;
+    }
 
-    for (unsigned i = 0; i < 6; ++i) {
-        measurement[i] = m_sensorReadings[startingIndex + i];
+    const unsigned offset = m_channelSize == 8 ? 1 : 0; //skip the first element
+    const unsigned channels = std::min<unsigned>(measurement.size(), getNumberOfChannels());
+    for (unsigned i = 0; i < channels; ++i) {
+        // the derived quantities follow the raw channels
+        measurement[i] = i < SAMPLE_CHANNELS ? sample[offset + i] : sample[m_channelSize + i - SAMPLE_CHANNELS];
     }
     if (timestamp) {
-        *timestamp =  m_timestamp;
+        *timestamp = yarp::os::Stamp(static_cast<int>(sequence), sampleTime);
     }
     return m_status;
 
 }
 
+int yarp::dev::AMTIPlatformsDriver::getNewSamples(ForcePlatesCursor& cursor,
+    unsigned maxSamples,
+    double *samples,
+    double *timestamps,
+    unsigned *sampleCount,
+    uint64_t *lostSamples)
+{
+    cursor.lastSequence.resize(m_numOfPlatforms, 0);
+    const unsigned offset = m_channelSize == 8 ? 1 : 0; //skip the counter
+    const unsigned channels = getNumberOfChannels();
+    double sample[8 + CHANNELS_WITH_DERIVED - SAMPLE_CHANNELS];
+
+    for (unsigned platform = 0; platform < m_numOfPlatforms; ++platform) {
+        const AMTISampleRing &ring = m_platforms[platform].ring;
+        uint64_t &last = cursor.lastSequence[platform];
+
+        uint64_t sequence = last + 1;
+        uint64_t lost = 0;
+        uint64_t oldest = ring.firstSequence();
+        if (sequence < oldest) {
+            // overwritten before being read (an empty cursor starts from the oldest sample)
+            lost = last == 0 ? 0 : oldest - sequence;
+            sequence = oldest;
+        }
+
+        double *out = samples + static_cast<size_t>(platform) * maxSamples * channels;
+        unsigned count = 0;
+        uint64_t newest = ring.lastSequence();
+        while (count < maxSamples && sequence <= newest) {
+            double sampleTime;
+            if (!ring.read(sequence, sample, sampleTime)) {
+                // overwritten while copying: skip to the oldest sample still available
+                oldest = ring.firstSequence();
+                if (oldest <= sequence) break;
+                lost += oldest - sequence;
+                sequence = oldest;
+                newest = ring.lastSequence();
+                continue;
+            }
+            std::copy(sample + offset, sample + offset + SAMPLE_CHANNELS, out + count * channels);
+            if (m_computeDerived) {
+                std::copy(sample + m_channelSize, sample + m_ringChannels, out + count * channels + SAMPLE_CHANNELS);
+            }
+            if (timestamps) {
+                timestamps[platform * maxSamples + count] = sampleTime;
+            }
+            count++;
+            sequence++;
+        }
+        if (sequence - 1 > last) {
+            last = sequence - 1;
+        }
+        sampleCount[platform] = count;
+        if (lostSamples) lostSamples[platform] = lost;
+    }
+    return m_status;
+}
+
 yarp::os::Stamp yarp::dev::AMTIPlatformsDriver::getLastInputStamp()
 {
-    return m_timestamp;
+    return yarp::os::Stamp(m_packetCount.load(), m_lastPacketTime.load());
 }
@@ -167,7 +167,7 @@ int getCurrentData(unsigned numOfPlatforms, unsigned channelSize, double* readin
     if (numberOfDataSets == 0) return 0;
     
     // Access only the 16th dataset
-    float *lastDataset = buffer + 15 * (channelSize * numOfPlatforms);
+    float *lastDataset = buffer + (AMTI_DATASETS_PER_PACKET - 1) * (channelSize * numOfPlatforms);
 
 	for (unsigned i = 0; i < (channelSize * numOfPlatforms); ++i) {
 		reading[i] = lastDataset[i];
@@ -184,7 +184,34 @@ int getLastDataPacket(unsigned numOfPlatforms, unsigned channelSize, double* rea
     if (numberOfDataSets == 0) return 0;
     // more than one dataset. Check the buffer pointer
 
-    std::copy(buffer, buffer +  16 * (channelSize * numOfPlatforms) - 1, reading);
+    std::copy(buffer, buffer + AMTI_DATASETS_PER_PACKET * (channelSize * numOfPlatforms), reading);
 
     return numberOfDataSets;
 }
+
+unsigned int getCurrentThreadIdentifier()
+{
+    // The thread messages queue is created on the first call to PeekMessage:
+    // it must exist before the driver posts the data-ready messages
+    MSG message;
+    PeekMessage(&message, NULL, WM_USER, WM_USER, PM_NOREMOVE);
+    return GetCurrentThreadId();
+}
+
+int waitForDataReady(unsigned timeoutInMilliseconds)
+{
+    MSG message;
+    bool notified = false;
+    // Consume all the pending notifications, as the data is drained afterwards anyway
+    while (PeekMessage(&message, NULL, 0, 0, PM_REMOVE)) {
+        notified = true;
+    }
+    if (notified) return 1;
+
+    DWORD result = MsgWaitForMultipleObjects(0, NULL, FALSE, timeoutInMilliseconds, QS_POSTMESSAGE);
+    if (result != WAIT_OBJECT_0) return 0;
+    while (PeekMessage(&message, NULL, 0, 0, PM_REMOVE)) {
+        notified = true;
+    }
+    return notified ? 1 : 0;
+}
@@ -0,0 +1,353 @@
+/*
+* Copyright (C) 2016 iCub Facility
+* Authors: Francesco Romano
+* CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+*/
+
+// Stand-in for AMTIlib.cpp which does not need the AMTI SDK (nor Windows).
+// It simulates a set of force plates producing blocks of AMTI_DATASETS_PER_PACKET datasets
+// at the configured acquisition rate, so that the devices can be built, run and benchmarked anywhere.
+//
+// The simulated setup is configured through environment variables:
+// - AMTI_SIM_PLATFORMS: number of platforms (default 2)
+// - AMTI_SIM_SERIALS: comma separated serial numbers (default SIM0, SIM1, ...)
+// - AMTI_SIM_TRIGGER_HZ: frequency of the trigger (genlock) square wave in the extended format (default 0, off)
+// - AMTI_SIM_MAX_BLOCKS: blocks buffered before the oldest ones are dropped (default 64)
+
+#include "AMTIlib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace {
+
+    struct SimulatedSetup {
+        std::mutex mutex;
+        bool initialized;
+        bool acquiring;
+        unsigned numOfPlatforms;
+        std::vector<std::string> serials;
+        int rate;
+        AMTI_DATAFORMAT format;
+        AMTI_RUNMODE runMode;
+        double triggerFrequency;
+        size_t maxBlocks;
+        std::chrono::steady_clock::time_point start;
+        uint64_t producedSamples;               /*!< samples generated since startAcquisition */
+        std::deque<std::vector<double> > blocks; /*!< blocks not yet transferred */
+        std::vector<double> offsets;            /*!< zeroing offsets, per platform and channel */
+
+        SimulatedSetup()
+            : initialized(false)
+            , acquiring(false)
+            , numOfPlatforms(0)
+            , rate(1000)
+            , format(AMTI_DATAFORMAT_ONLYDATA)
+            , runMode(AMTI_RUNMODE_POLL)
+            , triggerFrequency(0)
+            , maxBlocks(64)
+            , producedSamples(0) {}
+    };
+
+    SimulatedSetup& setup()
+    {
+        static SimulatedSetup instance;
+        return instance;
+    }
+
+    const int availableRatesTable[] = { 10, 15, 20, 25, 30, 40, 45, 50, 60, 75, 80, 90, 100, 120, 125, 150, 180,
+                                        200, 225, 240, 250, 300, 360, 400, 450, 500, 600, 800, 900, 1000, 1200,
+                                        1500, 1800, 2000 };
+
+    unsigned channelSize(const SimulatedSetup &sim)
+    {
+        return sim.format == AMTI_DATAFORMAT_EXTENDED ? 8 : 6;
+    }
+
+    /* Forces (N) and moments (N-m) of a person standing on the platform, swaying */
+    void simulatedWrench(unsigned platform, double time, double *wrench)
+    {
+        const double sway = 2 * 3.14159265358979323846 * 0.5 * time + platform;
+        wrench[0] = 5 * std::sin(sway);
+        wrench[1] = 5 * std::cos(sway);
+        wrench[2] = 350 + 20 * std::sin(2 * sway);
+        wrench[3] = 10 * std::cos(sway);
+        wrench[4] = -10 * std::sin(sway);
+        wrench[5] = 0.5 * std::sin(3 * sway);
+    }
+
+    /* Generate the blocks completed since the last call. Called with the mutex locked */
+    void produceBlocks(SimulatedSetup &sim)
+    {
+        if (!sim.acquiring || sim.numOfPlatforms == 0) {
+            return;
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - sim.start).count();
+        uint64_t dueSamples = static_cast<uint64_t>(elapsed * sim.rate);
+        const unsigned channels = channelSize(sim);
+
+        while (dueSamples >= sim.producedSamples + AMTI_DATASETS_PER_PACKET) {
+            std::vector<double> block(AMTI_DATASETS_PER_PACKET * channels * sim.numOfPlatforms);
+            for (unsigned dataset = 0; dataset < AMTI_DATASETS_PER_PACKET; ++dataset) {
+                uint64_t sampleIndex = sim.producedSamples + dataset;
+                double time = static_cast<double>(sampleIndex) / sim.rate;
+                for (unsigned platform = 0; platform < sim.numOfPlatforms; ++platform) {
+                    double *values = &block[(dataset * sim.numOfPlatforms + platform) * channels];
+                    double *wrench = channels == 8 ? values + 1 : values;
+                    simulatedWrench(platform, time, wrench);
+                    for (unsigned i = 0; i < 6; ++i) {
+                        wrench[i] -= sim.offsets[platform * 6 + i];
+                    }
+                    if (channels == 8) {
+                        values[0] = static_cast<double>(sampleIndex);
+                        values[7] = sim.triggerFrequency > 0 && std::fmod(time * sim.triggerFrequency, 1.0) < 0.5 ? 5.0 : 0.0;
+                    }
+                }
+            }
+            sim.producedSamples += AMTI_DATASETS_PER_PACKET;
+            sim.blocks.push_back(block);
+            if (sim.blocks.size() > sim.maxBlocks) {
+                // the SDK buffer overflows: the oldest block is lost
+                sim.blocks.pop_front();
+            }
+        }
+    }
+
+    int transferBlock(unsigned numOfPlatforms, unsigned channels, double *reading, bool onlyLastDataset)
+    {
+        SimulatedSetup &sim = setup();
+        std::lock_guard<std::mutex> guard(sim.mutex);
+        produceBlocks(sim);
+        if (sim.blocks.empty() || numOfPlatforms != sim.numOfPlatforms || channels != channelSize(sim)) {
+            return 0;
+        }
+        const std::vector<double> &block = sim.blocks.front();
+        const size_t datasetSize = channels * numOfPlatforms;
+        if (onlyLastDataset) {
+            std::copy(block.end() - datasetSize, block.end(), reading);
+        }
+        else {
+            std::copy(block.begin(), block.end(), reading);
+        }
+        sim.blocks.pop_front();
+        return AMTI_DATASETS_PER_PACKET;
+    }
+
+    void copyString(const std::string &value, char *out, size_t size)
+    {
+        std::strncpy(out, value.c_str(), size - 1);
+        out[size - 1] = '\0';
+    }
+}
+
+int loadDriver()
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+
+    const char *platforms = std::getenv("AMTI_SIM_PLATFORMS");
+    sim.numOfPlatforms = platforms ? static_cast<unsigned>(std::max(0, std::atoi(platforms))) : 2;
+    sim.serials.clear();
+    if (const char *serials = std::getenv("AMTI_SIM_SERIALS")) {
+        std::stringstream list(serials);
+        std::string serial;
+        while (std::getline(list, serial, ',')) {
+            sim.serials.push_back(serial);
+        }
+        if (!platforms) {
+            sim.numOfPlatforms = static_cast<unsigned>(sim.serials.size());
+        }
+    }
+    for (unsigned i = static_cast<unsigned>(sim.serials.size()); i < sim.numOfPlatforms; ++i) {
+        std::stringstream serial;
+        serial << "SIM" << i;
+        sim.serials.push_back(serial.str());
+    }
+    const char *trigger = std::getenv("AMTI_SIM_TRIGGER_HZ");
+    sim.triggerFrequency = trigger ? std::atof(trigger) : 0;
+    const char *maxBlocks = std::getenv("AMTI_SIM_MAX_BLOCKS");
+    sim.maxBlocks = maxBlocks ? static_cast<size_t>(std::max(1, std::atoi(maxBlocks))) : 64;
+
+    sim.offsets.assign(6 * sim.numOfPlatforms, 0.0);
+    sim.blocks.clear();
+    sim.acquiring = false;
+    sim.initialized = true;
+    return sim.numOfPlatforms > 0 ? 2 : 1;
+}
+
+int checkDriverStatus()
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    if (!sim.initialized) return 0;
+    return sim.numOfPlatforms > 0 ? 2 : 1;
+}
+
+void releaseDriver()
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    sim.initialized = false;
+    sim.acquiring = false;
+    sim.blocks.clear();
+}
+
+AMTI_CONFIGURATION_CHECK checkDriverConfiguration()
+{
+    return checkDriverStatus() == 2 ? AMTI_CONFIGURATION_CHECK_SETUP_IS_EQUAL : AMTI_CONFIGURATION_CHECK_NODEVICES;
+}
+
+void initDriverTransmissionParameters() {}
+
+void calibratePlatforms()
+{
+    // Zero the platforms on the current reading, as fmBroadcastZero does
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    double time = static_cast<double>(sim.producedSamples) / sim.rate;
+    for (unsigned platform = 0; platform < sim.numOfPlatforms; ++platform) {
+        simulatedWrench(platform, time, &sim.offsets[platform * 6]);
+        // keep the static load, as the platforms are zeroed while unloaded
+        sim.offsets[platform * 6 + 2] -= 350;
+    }
+}
+
+void startAcquisition()
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    sim.acquiring = true;
+    sim.start = std::chrono::steady_clock::now();
+    sim.producedSamples = 0;
+    sim.blocks.clear();
+}
+
+void stopAcquisition()
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    sim.acquiring = false;
+}
+
+void applyConfigurationChanges() {}
+
+void configureDriverRunMode(AMTI_RUNMODE runMode, unsigned int /*threadID*/)
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    sim.runMode = runMode;
+}
+
+void configureGenlock(AMTI_GENLOCK /*genlock*/) {}
+
+void configureDriverDataFormat(AMTI_DATAFORMAT format)
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    sim.format = format;
+    sim.blocks.clear();
+}
+
+void setAcquisitionRate(int samplePerSeconds)
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    if (samplePerSeconds > 0) {
+        sim.rate = samplePerSeconds;
+    }
+}
+
+int getAcquisitionRate(unsigned /*platformIndex*/)
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    return sim.rate;
+}
+
+void getAvailableAcquisitionRates(int *& availableRates, unsigned& count)
+{
+    count = sizeof(availableRatesTable) / sizeof(availableRatesTable[0]);
+    availableRates = new int[count];
+    std::copy(availableRatesTable, availableRatesTable + count, availableRates);
+}
+
+int getPlatformsCount()
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    return static_cast<int>(sim.numOfPlatforms);
+}
+
+void getPlatformModelNumber(unsigned /*platformIndex*/, char *platformModelNumber)
+{
+    copyString("SIM-GEN5", platformModelNumber, 16);
+}
+
+void getPlatformSerialNumber(unsigned platformIndex, char *platformSerialNumber)
+{
+    SimulatedSetup &sim = setup();
+    std::lock_guard<std::mutex> guard(sim.mutex);
+    copyString(platformIndex < sim.serials.size() ? sim.serials[platformIndex] : "", platformSerialNumber, 16);
+}
+
+void getPlatformFirmwareVersion(unsigned /*platformIndex*/, char *platformFWVersion)
+{
+    copyString("sim", platformFWVersion, 16);
+}
+
+void getPlatformLastCalibrationDate(unsigned /*platformIndex*/, char *platformDate)
+{
+    copyString("2016-01-01", platformDate, 12);
+}
+
+int getCurrentData(unsigned numOfPlatforms, unsigned channelSize, double* reading)
+{
+    return transferBlock(numOfPlatforms, channelSize, reading, true);
+}
+
+int getLastDataPacket(unsigned numOfPlatforms, unsigned channelSize, double* reading)
+{
+    return transferBlock(numOfPlatforms, channelSize, reading, false);
+}
+
+unsigned int getCurrentThreadIdentifier()
+{
+    return static_cast<unsigned int>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+
+int waitForDataReady(unsigned timeoutInMilliseconds)
+{
+    // The notification is sent when a block completes: sleep until the next one is due
+    SimulatedSetup &sim = setup();
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutInMilliseconds);
+    std::chrono::steady_clock::time_point nextBlock;
+    {
+        std::lock_guard<std::mutex> guard(sim.mutex);
+        if (sim.runMode != AMTI_RUNMODE_CALLBACK || !sim.acquiring || sim.numOfPlatforms == 0) {
+            nextBlock = deadline;
+        }
+        else {
+            produceBlocks(sim);
+            if (!sim.blocks.empty()) return 1;
+            double due = static_cast<double>(sim.producedSamples + AMTI_DATASETS_PER_PACKET) / sim.rate;
+            nextBlock = sim.start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(due));
+        }
+    }
+    if (nextBlock > deadline) {
+        std::this_thread::sleep_until(deadline);
+        return 0;
+    }
+    std::this_thread::sleep_until(nextBlock);
+    return 1;
+}
@@ -0,0 +1,9 @@
+/*
+* Copyright (C) 2016 iCub Facility
+* Authors: Francesco Romano
+* CopyPolicy: Released under the terms of the LGPLv2.1 or later, see LGPL.TXT
+*/
+
+#include "IForcePlatesMetadata.h"
+
+yarp::dev::IForcePlatesMetadata::~IForcePlatesMetadata() {}
@@ -6,4 +6,49 @@
 
 #include "IMultipleForcePlates.h"
 
+#include <yarp/dev/IAnalogSensor.h>
+
 yarp::dev::IMultipleForcePlates::~IMultipleForcePlates() {}
+
+unsigned yarp::dev::IMultipleForcePlates::getNumberOfChannels() { return SAMPLE_CHANNELS; }
+
+bool yarp::dev::IMultipleForcePlates::getLastSyncEdge(const unsigned /*platformIndex*/, double& /*edgeTime*/, uint64_t& /*sequence*/) { return false; }
+
+int yarp::dev::IMultipleForcePlates::getNewSamples(ForcePlatesCursor& cursor,
+                                                   unsigned maxSamples,
+                                                   double *samples,
+                                                   double *timestamps,
+                                                   unsigned *sampleCount,
+                                                   uint64_t *lostSamples)
+{
+    int numberOfPlatforms = getNumberOfPlatforms();
+    if (numberOfPlatforms < 0) numberOfPlatforms = 0;
+    cursor.lastSequence.resize(numberOfPlatforms, 0);
+
+    int status = yarp::dev::IAnalogSensor::AS_OK;
+    const unsigned channels = getNumberOfChannels();
+    yarp::sig::Vector measurement(channels);
+    yarp::os::Stamp stamp;
+    for (int platform = 0; platform < numberOfPlatforms; ++platform) {
+        sampleCount[platform] = 0;
+        if (lostSamples) lostSamples[platform] = 0;
+
+        int platformStatus = getLastMeasurementForPlateAtIndex(platform, measurement, &stamp);
+        if (platformStatus != yarp::dev::IAnalogSensor::AS_OK) status = platformStatus;
+
+        uint64_t sequence = static_cast<uint64_t>(stamp.getCount());
+        if (maxSamples == 0 || sequence == cursor.lastSequence[platform]) {
+            continue;
+        }
+        if (lostSamples && cursor.lastSequence[platform] != 0 && sequence > cursor.lastSequence[platform] + 1) {
+            lostSamples[platform] = sequence - cursor.lastSequence[platform] - 1;
+        }
+        for (unsigned i = 0; i < channels; ++i) {
+            samples[platform * maxSamples * channels + i] = measurement[i];
+        }
+        if (timestamps) timestamps[platform * maxSamples] = stamp.getTime();
+        sampleCount[platform] = 1;
+        cursor.lastSequence[platform] = sequence;
+    }
+    return status;
+}